@@ -0,0 +1,34 @@
+#!/bin/bash
+
+# Build script for the native batch renderer (Linux/Mac)
+# Compiles the same filter/transition kernels as the WASM modules for
+# offline rendering and profiling. Requires a C++17 compiler.
+
+echo "🔨 Building Nebula native tools..."
+
+CXX=${CXX:-c++}
+
+if ! command -v $CXX &> /dev/null; then
+    echo "❌ Error: C++ compiler '$CXX' not found. Set CXX or install g++/clang++."
+    exit 1
+fi
+
+# Create output directory
+mkdir -p build-native
+
+# Build Batch Renderer
+echo "🎬 Building batch-render..."
+$CXX src/wasm/batch-render.cpp \
+    -std=c++17 \
+    -O3 \
+    -g \
+    -pthread \
+    ${NATIVE_CXXFLAGS:--march=native} \
+    -o build-native/batch-render
+
+if [ $? -eq 0 ]; then
+    echo "✅ batch-render built successfully → build-native/batch-render"
+else
+    echo "❌ Failed to build batch-render"
+    exit 1
+fi
@@ -95,6 +95,51 @@ if ($LASTEXITCODE -eq 0) {
     exit 1
 }
 
+# Build Audio Peak Index (waveform overview pyramid)
+Write-Host "Building audio-peak-index.wasm..." -ForegroundColor Yellow
+em++ src\wasm\audio-peak-index.cpp `
+    -O3 `
+    -msimd128 `
+    -s WASM=1 `
+    -s MODULARIZE=1 `
+    -s EXPORT_ES6=1 `
+    -s EXPORT_NAME="createAudioPeakIndexModule" `
+    -s ALLOW_MEMORY_GROWTH=1 `
+    -s MAXIMUM_MEMORY=256MB `
+    -s EXPORTED_FUNCTIONS="['_malloc','_free']" `
+    -s EXPORTED_RUNTIME_METHODS="['HEAPU8','HEAPF32']" `
+    --bind `
+    -o public\wasm\audio-peak-index.js
+
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "audio-peak-index.wasm built successfully" -ForegroundColor Green
+} else {
+    Write-Host "Failed to build audio-peak-index.wasm" -ForegroundColor Red
+    exit 1
+}
+
+# Build Video Filters (SIMD128 for the streaming convolution engine)
+Write-Host "Building video-filters.wasm..." -ForegroundColor Yellow
+em++ src\wasm\video-filters.cpp `
+    -O3 `
+    -msimd128 `
+    -s WASM=1 `
+    -s MODULARIZE=1 `
+    -s EXPORT_NAME="createVideoFiltersModule" `
+    -s ALLOW_MEMORY_GROWTH=1 `
+    -s MAXIMUM_MEMORY=512MB `
+    -s EXPORTED_FUNCTIONS="['_malloc','_free']" `
+    -s EXPORTED_RUNTIME_METHODS="['HEAPU8']" `
+    --bind `
+    -o public\wasm\video-filters.js
+
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "video-filters.wasm built successfully" -ForegroundColor Green
+} else {
+    Write-Host "Failed to build video-filters.wasm" -ForegroundColor Red
+    exit 1
+}
+
 # Display sizes
 Write-Host ""
 Write-Host "Build Summary:" -ForegroundColor Cyan
@@ -55,6 +55,51 @@ else
     exit 1
 fi
 
+# Build Audio Peak Index (waveform overview pyramid)
+echo "📈 Building audio-peak-index.wasm..."
+em++ src/wasm/audio-peak-index.cpp \
+    -O3 \
+    -msimd128 \
+    -s WASM=1 \
+    -s MODULARIZE=1 \
+    -s EXPORT_ES6=1 \
+    -s EXPORT_NAME="createAudioPeakIndexModule" \
+    -s ALLOW_MEMORY_GROWTH=1 \
+    -s MAXIMUM_MEMORY=256MB \
+    -s EXPORTED_FUNCTIONS="['_malloc','_free']" \
+    -s EXPORTED_RUNTIME_METHODS="['HEAPU8','HEAPF32']" \
+    --bind \
+    -o public/wasm/audio-peak-index.js
+
+if [ $? -eq 0 ]; then
+    echo "✅ audio-peak-index.wasm built successfully"
+else
+    echo "❌ Failed to build audio-peak-index.wasm"
+    exit 1
+fi
+
+# Build Video Filters (SIMD128 for the streaming convolution engine)
+echo "🎨 Building video-filters.wasm..."
+em++ src/wasm/video-filters.cpp \
+    -O3 \
+    -msimd128 \
+    -s WASM=1 \
+    -s MODULARIZE=1 \
+    -s EXPORT_NAME="createVideoFiltersModule" \
+    -s ALLOW_MEMORY_GROWTH=1 \
+    -s MAXIMUM_MEMORY=512MB \
+    -s EXPORTED_FUNCTIONS="['_malloc','_free']" \
+    -s EXPORTED_RUNTIME_METHODS="['HEAPU8']" \
+    --bind \
+    -o public/wasm/video-filters.js
+
+if [ $? -eq 0 ]; then
+    echo "✅ video-filters.wasm built successfully"
+else
+    echo "❌ Failed to build video-filters.wasm"
+    exit 1
+fi
+
 # Display sizes
 echo ""
 echo "📊 Build Summary:"
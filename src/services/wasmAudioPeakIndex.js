@@ -0,0 +1,150 @@
+/**
+ * WASM Audio Peak Index Service
+ * Multi-resolution min/max/RMS index for drawing long waveforms.
+ * Build the index while recording or importing, store the serialized blob
+ * next to the recording, and render any zoom level in O(pixels).
+ */
+
+// Frames copied into WASM memory per append call
+const APPEND_CHUNK_FRAMES = 65536;
+
+class WASMAudioPeakIndexService {
+  constructor() {
+    this.module = null;
+    this.isInitialized = false;
+    this.scratchPtr = 0;
+    this.scratchBytes = 0;
+  }
+
+  async initialize() {
+    if (this.isInitialized) return;
+
+    try {
+      const createModule = await import('/wasm/audio-peak-index.js');
+      this.module = await createModule.default();
+      this.isInitialized = true;
+      console.log('✅ WASM Audio Peak Index initialized');
+    } catch (error) {
+      console.error('❌ Failed to initialize WASM Audio Peak Index:', error);
+      throw error;
+    }
+  }
+
+  /**
+   * Create an empty index
+   * @param {number} channels
+   * @param {number} sampleRate
+   * @param {Object} layout - { bucketFrames = 256, fanout = 16, levels = 3 }
+   * @returns {Object} Index handle (release with release())
+   */
+  createIndex(channels, sampleRate, layout = {}) {
+    if (!this.module) throw new Error('Peak index not initialized');
+
+    const { bucketFrames = 256, fanout = 16, levels = 3 } = layout;
+    const index = new this.module.AudioPeakIndex();
+    index.reset(channels, sampleRate);
+    index.setLayout(bucketFrames, fanout, levels);
+    return index;
+  }
+
+  /**
+   * Append captured or decoded audio
+   * @param {Object} index
+   * @param {Float32Array[]|Float32Array} audio - One array per channel
+   *        (e.g. AudioBuffer.getChannelData), or a single interleaved array
+   */
+  append(index, audio) {
+    if (!this.module) throw new Error('Peak index not initialized');
+
+    const channels = index.getChannels();
+    const planar = Array.isArray(audio);
+    const frames = planar ? audio[0].length : Math.floor(audio.length / channels);
+
+    for (let offset = 0; offset < frames; offset += APPEND_CHUNK_FRAMES) {
+      const count = Math.min(APPEND_CHUNK_FRAMES, frames - offset);
+      const ptr = this.ensureScratch(count * channels * 4);
+      const heap = this.module.HEAPF32;
+
+      if (planar) {
+        for (let c = 0; c < channels; c++) {
+          heap.set(audio[c].subarray(offset, offset + count), (ptr >> 2) + c * count);
+        }
+        index.appendPlanar(ptr, count);
+      } else {
+        heap.set(audio.subarray(offset * channels, (offset + count) * channels), ptr >> 2);
+        index.appendInterleaved(ptr, count);
+      }
+    }
+  }
+
+  /**
+   * Summarise a frame range for drawing
+   * @param {Object} index
+   * @param {number} startFrame
+   * @param {number} endFrame
+   * @param {number} pixels - Output columns
+   * @param {number} channel - Channel index, or -1 for all channels
+   * @returns {Float32Array} pixels x (min, max, rms)
+   */
+  render(index, startFrame, endFrame, pixels, channel = -1) {
+    if (!this.module) throw new Error('Peak index not initialized');
+    return new Float32Array(index.render(channel, startFrame, endFrame, pixels));
+  }
+
+  /**
+   * Serialize for storage next to the recording
+   * @returns {Uint8Array}
+   */
+  serialize(index) {
+    if (!this.module) throw new Error('Peak index not initialized');
+    return new Uint8Array(index.serialize());
+  }
+
+  /**
+   * Load a stored index (appends may continue afterwards)
+   * @param {Uint8Array|ArrayBuffer} blob
+   * @returns {Object} Index handle
+   */
+  deserialize(blob) {
+    if (!this.module) throw new Error('Peak index not initialized');
+
+    const bytes = blob instanceof Uint8Array ? blob : new Uint8Array(blob);
+    const index = new this.module.AudioPeakIndex();
+    const ptr = this.module._malloc(bytes.length);
+
+    try {
+      this.module.HEAPU8.set(bytes, ptr);
+      if (!index.deserialize(ptr, bytes.length)) {
+        index.delete();
+        throw new Error('Invalid peak index blob');
+      }
+      return index;
+    } finally {
+      this.module._free(ptr);
+    }
+  }
+
+  /**
+   * Free an index
+   */
+  release(index) {
+    index.delete();
+  }
+
+  /**
+   * Reusable WASM buffer for append chunks
+   */
+  ensureScratch(bytes) {
+    if (bytes > this.scratchBytes) {
+      if (this.scratchPtr) this.module._free(this.scratchPtr);
+      this.scratchPtr = this.module._malloc(bytes);
+      this.scratchBytes = bytes;
+    }
+    return this.scratchPtr;
+  }
+}
+
+// Create singleton instance
+const wasmAudioPeakIndex = new WASMAudioPeakIndexService();
+
+export default wasmAudioPeakIndex;
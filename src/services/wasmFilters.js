@@ -8,6 +8,9 @@ class WasmFiltersService {
   constructor() {
     this.module = null;
     this.processor = null;
+    this.scopes = null;
+    this.scopeRowsPtr = 0;
+    this.scopeRowsBytes = 0;
     this.isReady = false;
   }
 
@@ -78,6 +81,7 @@ class WasmFiltersService {
       }
       
       this.processor = new this.module.VideoFilters();
+      this.scopes = new this.module.VideoScopes();
       this.isReady = true;
       console.log('✅ WASM Filters Module Initialized - 10-20x faster processing!');
     } catch (error) {
@@ -131,13 +135,22 @@ class WasmFiltersService {
   /**
    * Apply chroma key (green screen) effect
    * @param {ImageData} imageData - Frame to process
-   * @param {Object} options - { color, tolerance, softness, spillSuppression }
+   * @param {Object} options - { color, tolerance, softness, spillSuppression,
+   *   matteShrink (1 erode, -1 dilate), feather, temporalSmoothing }
    * @returns {ImageData} Processed frame
    */
   async applyChromaKey(imageData, options = {}) {
     await this.ensureReady();
     
-    const { color = '#00ff00', tolerance = 0.4, softness = 0.1, spillSuppression = 0.3 } = options;
+    const {
+      color = '#00ff00',
+      tolerance = 0.4,
+      softness = 0.1,
+      spillSuppression = 0.3,
+      matteShrink = 0,
+      feather = 0,
+      temporalSmoothing = 0
+    } = options;
     
     // Parse hex color
     const hex = color.replace('#', '');
@@ -150,7 +163,8 @@ class WasmFiltersService {
     const ptr = this.allocateFrame(imageData);
     
     try {
-      this.processor.chromaKey(ptr, r, g, b, tolerance, softness, spillSuppression);
+      this.processor.chromaKeyAdvanced(ptr, r, g, b, tolerance, softness, spillSuppression,
+                                       Math.round(matteShrink), feather, temporalSmoothing);
       this.copyFromWasm(ptr, imageData);
       return imageData;
     } finally {
@@ -158,6 +172,15 @@ class WasmFiltersService {
     }
   }
 
+  /**
+   * Reset chroma key temporal smoothing (call on seek or scene change)
+   */
+  resetChromaKey() {
+    if (this.processor) {
+      this.processor.resetChromaKey();
+    }
+  }
+
   /**
    * Apply color grading
    * @param {ImageData} imageData - Frame to process
@@ -226,6 +249,74 @@ class WasmFiltersService {
     }
   }
 
+  /**
+   * Apply unsharp mask
+   * @param {ImageData} imageData - Frame to process
+   * @param {Object} options - { radius, amount, threshold }
+   * @returns {ImageData} Processed frame
+   */
+  async applyUnsharpMask(imageData, options = {}) {
+    await this.ensureReady();
+    
+    const { radius = 2, amount = 1.0, threshold = 0 } = options;
+    
+    this.setDimensions(imageData.width, imageData.height);
+    
+    const ptr = this.allocateFrame(imageData);
+    
+    try {
+      this.processor.unsharpMask(ptr, Math.round(radius), amount, Math.round(threshold));
+      this.copyFromWasm(ptr, imageData);
+      return imageData;
+    } finally {
+      this.freeFrame(ptr);
+    }
+  }
+
+  /**
+   * Apply Sobel edge detection
+   * @param {ImageData} imageData - Frame to process
+   * @param {number} strength - Output gain (0-4)
+   * @returns {ImageData} Processed frame
+   */
+  async applyEdgeDetect(imageData, strength = 1.0) {
+    await this.ensureReady();
+    
+    this.setDimensions(imageData.width, imageData.height);
+    
+    const ptr = this.allocateFrame(imageData);
+    
+    try {
+      this.processor.edgeDetect(ptr, strength);
+      this.copyFromWasm(ptr, imageData);
+      return imageData;
+    } finally {
+      this.freeFrame(ptr);
+    }
+  }
+
+  /**
+   * Apply emboss effect
+   * @param {ImageData} imageData - Frame to process
+   * @param {number} strength - Effect strength (0-2)
+   * @returns {ImageData} Processed frame
+   */
+  async applyEmboss(imageData, strength = 1.0) {
+    await this.ensureReady();
+    
+    this.setDimensions(imageData.width, imageData.height);
+    
+    const ptr = this.allocateFrame(imageData);
+    
+    try {
+      this.processor.emboss(ptr, strength);
+      this.copyFromWasm(ptr, imageData);
+      return imageData;
+    } finally {
+      this.freeFrame(ptr);
+    }
+  }
+
   /**
    * Apply vignette effect
    * @param {ImageData} imageData - Frame to process
@@ -272,6 +363,40 @@ class WasmFiltersService {
     }
   }
 
+  /**
+   * Apply temporal noise reduction (accumulates static regions across frames)
+   * @param {ImageData} imageData - Frame to process
+   * @param {Object} options - { strength (0-1), threshold (1-64; 8 holds
+   *        webcam-grade noise up to sigma ~5 as static) }
+   * @returns {ImageData} Processed frame
+   */
+  async applyTemporalDenoise(imageData, options = {}) {
+    await this.ensureReady();
+    
+    const { strength = 0.5, threshold = 8 } = options;
+    
+    this.setDimensions(imageData.width, imageData.height);
+    
+    const ptr = this.allocateFrame(imageData);
+    
+    try {
+      this.processor.temporalDenoise(ptr, strength, Math.round(threshold));
+      this.copyFromWasm(ptr, imageData);
+      return imageData;
+    } finally {
+      this.freeFrame(ptr);
+    }
+  }
+
+  /**
+   * Drop temporal denoise history (call on seek or source change)
+   */
+  resetTemporalDenoise() {
+    if (this.processor) {
+      this.processor.resetTemporalDenoise();
+    }
+  }
+
   /**
    * Apply LUT (Look-Up Table) color grading
    * @param {ImageData} imageData - Frame to process
@@ -302,6 +427,85 @@ class WasmFiltersService {
     }
   }
 
+  /**
+   * Copy the rows the scopes sample into a persistent WASM buffer and analyze them
+   * Only every sampleStep-th row crosses into WASM memory (1/8 of the frame
+   * at the default step), and the buffer is reused between calls. The
+   * native scope timings cover analyzeRows() alone; this copy comes on top.
+   */
+  analyzeSampledRows(imageData, sampleStep) {
+    const step = Math.max(1, Math.round(sampleStep));
+    const rowBytes = imageData.width * 4;
+    const rows = this.scopes.sampledRows(step);
+    const bytes = rows * rowBytes;
+    
+    if (bytes > this.scopeRowsBytes) {
+      if (this.scopeRowsPtr) this.module._free(this.scopeRowsPtr);
+      this.scopeRowsPtr = this.module._malloc(bytes);
+      this.scopeRowsBytes = bytes;
+    }
+    
+    const heap = this.module.HEAPU8;
+    for (let row = 0; row < rows; row++) {
+      const offset = row * step * rowBytes;
+      heap.set(imageData.data.subarray(offset, offset + rowBytes), this.scopeRowsPtr + row * rowBytes);
+    }
+    
+    this.scopes.analyzeRows(this.scopeRowsPtr, step);
+  }
+
+  /**
+   * Analyze a frame for histogram, waveform and vectorscope displays
+   * @param {ImageData} imageData - Frame to analyze
+   * @param {Object} options - { sampleStep (every Nth column of every Nth row;
+   *                              1 = exact, 8 = ~32k samples at 1080p), waveformWidth }
+   * @returns {Object} { red, green, blue, luma, waveform, waveformWidth, vectorscope, samples }
+   */
+  async analyzeFrame(imageData, options = {}) {
+    await this.ensureReady();
+    
+    const { sampleStep = 8, waveformWidth = 256 } = options;
+    
+    this.scopes.setDimensions(imageData.width, imageData.height);
+    if (this.scopes.getWaveformWidth() !== waveformWidth) {
+      this.scopes.setWaveformWidth(waveformWidth);
+    }
+    
+    this.analyzeSampledRows(imageData, sampleStep);
+    
+    // Copy out of WASM memory (views are invalidated by the next analyze)
+    return {
+      red: new Uint32Array(this.scopes.histogram(0)),
+      green: new Uint32Array(this.scopes.histogram(1)),
+      blue: new Uint32Array(this.scopes.histogram(2)),
+      luma: new Uint32Array(this.scopes.histogram(3)),
+      waveform: new Uint32Array(this.scopes.waveform()),
+      waveformWidth,
+      vectorscope: new Uint32Array(this.scopes.vectorscope()),
+      samples: this.scopes.sampleCount()
+    };
+  }
+
+  /**
+   * Suggest auto-levels and white balance for a frame
+   * @param {ImageData} imageData - Frame to analyze
+   * @param {Object} options - { sampleStep, clipPercent }
+   * @returns {Object} { colorGrade: { brightness, contrast }, lut: { temperature, warmth } }
+   */
+  async getAutoGrade(imageData, options = {}) {
+    await this.ensureReady();
+    
+    const { sampleStep = 8, clipPercent = 0.5 } = options;
+    
+    this.scopes.setDimensions(imageData.width, imageData.height);
+    this.analyzeSampledRows(imageData, sampleStep);
+    
+    return {
+      colorGrade: this.scopes.autoLevels(clipPercent),
+      lut: this.scopes.autoWhiteBalance()
+    };
+  }
+
   /**
    * Apply multiple filters in sequence
    * @param {ImageData} imageData - Frame to process
@@ -323,12 +527,24 @@ class WasmFiltersService {
         case 'sharpen':
           await this.applySharpen(imageData, filter.amount);
           break;
+        case 'unsharpMask':
+          await this.applyUnsharpMask(imageData, filter.options);
+          break;
+        case 'edgeDetect':
+          await this.applyEdgeDetect(imageData, filter.strength);
+          break;
+        case 'emboss':
+          await this.applyEmboss(imageData, filter.strength);
+          break;
         case 'vignette':
           await this.applyVignette(imageData, filter.options);
           break;
         case 'noiseReduction':
           await this.applyNoiseReduction(imageData, filter.strength);
           break;
+        case 'temporalDenoise':
+          await this.applyTemporalDenoise(imageData, filter.options);
+          break;
         case 'lut':
           await this.applyLUT(imageData, filter.options);
           break;
@@ -0,0 +1,71 @@
+/**
+ * Audio Peak Index - Embind exports
+ * Frame positions cross the JS boundary as doubles (exact up to 2^53 frames).
+ */
+
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+#include "audio-peak-index.h"
+
+using namespace emscripten;
+
+static void appendInterleaved(AudioPeakIndex& self, uintptr_t samplesPtr, double frames) {
+    self.appendInterleaved(reinterpret_cast<const float*>(samplesPtr), static_cast<size_t>(frames));
+}
+
+static void appendPlanar(AudioPeakIndex& self, uintptr_t samplesPtr, double frames) {
+    self.appendPlanar(reinterpret_cast<const float*>(samplesPtr), static_cast<size_t>(frames));
+}
+
+static void reserve(AudioPeakIndex& self, double expectedFrames) {
+    self.reserve(static_cast<uint64_t>(expectedFrames));
+}
+
+// pixels x (min, max, rms) as a Float32Array view, valid until the next render
+static val render(AudioPeakIndex& self, int channel, double startFrame, double endFrame, int pixels) {
+    const float* columns = self.render(channel, static_cast<uint64_t>(std::max(0.0, startFrame)),
+                                       static_cast<uint64_t>(std::max(0.0, endFrame)), pixels);
+    return val(typed_memory_view(self.renderSize(), columns));
+}
+
+// Uint8Array view of the blob, valid until the next serialize
+static val serialize(AudioPeakIndex& self) {
+    const uint8_t* blob = self.serialize();
+    return val(typed_memory_view(self.serializedSize(), blob));
+}
+
+static bool deserialize(AudioPeakIndex& self, uintptr_t blobPtr, double size) {
+    return self.deserialize(reinterpret_cast<const uint8_t*>(blobPtr), static_cast<size_t>(size));
+}
+
+static double frameCount(AudioPeakIndex& self) {
+    return static_cast<double>(self.frameCount());
+}
+
+static double bucketFrames(AudioPeakIndex& self, int level) {
+    return static_cast<double>(self.bucketFrames(level));
+}
+
+static double bucketCount(AudioPeakIndex& self, int level) {
+    return static_cast<double>(self.bucketCount(level));
+}
+
+// Bind C++ class to JavaScript
+EMSCRIPTEN_BINDINGS(audio_peak_index_module) {
+    class_<AudioPeakIndex>("AudioPeakIndex")
+        .constructor<>()
+        .function("reset", &AudioPeakIndex::reset)
+        .function("setLayout", &AudioPeakIndex::setLayout)
+        .function("reserve", &reserve)
+        .function("appendInterleaved", &appendInterleaved)
+        .function("appendPlanar", &appendPlanar)
+        .function("render", &render)
+        .function("serialize", &serialize)
+        .function("deserialize", &deserialize)
+        .function("getChannels", &AudioPeakIndex::getChannels)
+        .function("getSampleRate", &AudioPeakIndex::getSampleRate)
+        .function("getLevels", &AudioPeakIndex::getLevels)
+        .function("frameCount", &frameCount)
+        .function("bucketFrames", &bucketFrames)
+        .function("bucketCount", &bucketCount);
+}
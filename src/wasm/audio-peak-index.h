@@ -0,0 +1,429 @@
+/**
+ * Audio Peak Index - Multi-resolution min/max/RMS pyramid for waveforms
+ * Built incrementally while audio is captured or imported so drawing or
+ * zooming the waveform of a long recording never re-scans the samples:
+ * - Level 0 summarises every baseBucket frames (default 256)
+ * - Each higher level summarises fanout buckets of the level below
+ *   (default 16, giving 256 / 4096 / 65536-frame buckets)
+ * - render() picks the coarsest level that still resolves one pixel, so
+ *   the cost is O(pixels) at any zoom
+ * - serialize() / deserialize() round-trip the index, including the
+ *   partially filled tail buckets, so appends can resume after a reload
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <cstring>
+
+// One summarised bucket of one channel
+struct PeakBucket {
+    int16_t min; // sample * 32767
+    int16_t max;
+    uint16_t rms; // rms * 65535
+};
+
+static_assert(sizeof(PeakBucket) == 6, "PeakBucket must stay packed for serialization");
+
+class AudioPeakIndex {
+public:
+    static constexpr uint32_t kMagic = 0x494b504e; // "NPKI" little-endian
+    static constexpr uint16_t kVersion = 1;
+    static constexpr int kMaxLevels = 8;
+    static constexpr uint64_t kMaxBucketFrames = 1ull << 48; // top-level bucket limit
+
+    AudioPeakIndex() : channels(2), sampleRate(48000), baseBucket(256), fanout(16), levels(3) {
+        clear();
+    }
+
+    /**
+     * Start a new, empty index
+     * @param channelCount - Audio channels (1-32)
+     * @param rate - Sample rate in Hz (stored for the caller, not used here)
+     */
+    void reset(int channelCount, int rate) {
+        channels = std::max(1, std::min(32, channelCount));
+        sampleRate = std::max(1, rate);
+        clear();
+    }
+
+    /**
+     * Change the pyramid shape; clears the index
+     * @param bucketFrames - Frames per level-0 bucket (16-65536)
+     * @param levelFanout - Buckets merged per higher-level bucket (2-256)
+     * @param levelCount - Number of levels (1-8), reduced until the top
+     *                     bucket is at most kMaxBucketFrames
+     */
+    void setLayout(int bucketFrames, int levelFanout, int levelCount) {
+        baseBucket = std::max(16, std::min(65536, bucketFrames));
+        fanout = std::max(2, std::min(256, levelFanout));
+        levels = std::max(1, std::min(kMaxLevels, levelCount));
+        while (!layoutFits(baseBucket, fanout, levels)) levels--;
+        clear();
+    }
+
+    /**
+     * Pre-size the bucket storage when the final length is known (imports)
+     */
+    void reserve(uint64_t expectedFrames) {
+        for (int level = 0; level < levels; level++) {
+            buckets[level].reserve(static_cast<size_t>(expectedFrames / bucketFrames(level) + 1) * channels);
+        }
+    }
+
+    /**
+     * Append interleaved samples (L R L R ...)
+     * @param samples - frames * channels floats in [-1, 1]
+     * @param frames - Number of sample frames
+     */
+    void appendInterleaved(const float* samples, size_t frames) {
+        append(samples, frames, 1, channels);
+    }
+
+    /**
+     * Append planar samples (all of channel 0, then all of channel 1, ...)
+     * @param samples - channels blocks of frames floats in [-1, 1]
+     * @param frames - Number of sample frames
+     */
+    void appendPlanar(const float* samples, size_t frames) {
+        append(samples, frames, frames, 1);
+    }
+
+    /**
+     * Summarise a frame range for drawing
+     * @param channel - Channel index, or -1 to merge all channels
+     * @param startFrame - First frame of the visible range
+     * @param endFrame - One past the last visible frame
+     * @param pixels - Output columns
+     * @returns pixels x (min, max, rms) floats, valid until the next call.
+     *          Columns past the end of the audio are zero. Below baseBucket
+     *          frames per pixel, columns repeat the level-0 bucket; draw the
+     *          raw samples at that zoom instead.
+     */
+    const float* render(int channel, uint64_t startFrame, uint64_t endFrame, int pixels) {
+        pixels = std::max(1, pixels);
+        columns.assign(static_cast<size_t>(pixels) * 3, 0.0f);
+        if (endFrame <= startFrame || startFrame >= frames) return columns.data();
+
+        int first = channel < 0 ? 0 : std::min(channel, channels - 1);
+        int last = channel < 0 ? channels : first + 1;
+
+        uint64_t span = endFrame - startFrame;
+        double framesPerPixel = static_cast<double>(span) / pixels;
+        int level = 0;
+        while (level + 1 < levels && bucketFrames(level + 1) <= framesPerPixel) level++;
+        uint64_t size = bucketFrames(level);
+
+        for (int p = 0; p < pixels; p++) {
+            uint64_t from = startFrame + span * p / pixels;
+            uint64_t to = std::min(frames, startFrame + span * (p + 1) / pixels);
+            if (from >= frames) break;
+
+            uint64_t firstBucket = from / size;
+            uint64_t lastBucket = std::max(firstBucket + 1, (to + size - 1) / size);
+
+            Summary s;
+            for (int c = first; c < last; c++) gather(level, firstBucket, lastBucket, c, s);
+
+            if (s.count == 0) continue;
+            float* out = &columns[static_cast<size_t>(p) * 3];
+            out[0] = s.min;
+            out[1] = s.max;
+            out[2] = static_cast<float>(std::sqrt(s.sumSquares / s.count));
+        }
+        return columns.data();
+    }
+
+    size_t renderSize() const { return columns.size(); }
+
+    /**
+     * Serialize to a compact little-endian blob (valid until the next call)
+     * Layout: magic, version, channels, sampleRate, baseBucket, fanout,
+     * levels, frame count, the per-level tail accumulators, then each
+     * level's complete buckets (count derived from the frame count).
+     */
+    const uint8_t* serialize() {
+        blob.clear();
+        put(kMagic);
+        put(kVersion);
+        put(static_cast<uint16_t>(channels));
+        put(static_cast<uint32_t>(sampleRate));
+        put(static_cast<uint32_t>(baseBucket));
+        put(static_cast<uint16_t>(fanout));
+        put(static_cast<uint16_t>(levels));
+        put(frames);
+        for (int level = 0; level < levels; level++) {
+            for (int c = 0; c < channels; c++) {
+                const Summary& s = pending[level * channels + c];
+                put(s.min);
+                put(s.max);
+                put(s.sumSquares);
+                put(s.count);
+            }
+        }
+        for (int level = 0; level < levels; level++) {
+            size_t offset = blob.size();
+            size_t bytes = buckets[level].size() * sizeof(PeakBucket);
+            blob.resize(offset + bytes);
+            if (bytes > 0) std::memcpy(&blob[offset], buckets[level].data(), bytes);
+        }
+        return blob.data();
+    }
+
+    size_t serializedSize() const { return blob.size(); }
+
+    /**
+     * Load an index produced by serialize()
+     * @returns false (leaving the index empty) if the blob is malformed
+     */
+    bool deserialize(const uint8_t* data, size_t size) {
+        const uint8_t* end = data + size;
+        uint32_t magic, rate, bucket;
+        uint16_t version, channelCount, levelFanout, levelCount;
+        uint64_t frameCount;
+
+        clear();
+        if (!get(data, end, magic) || magic != kMagic) return false;
+        if (!get(data, end, version) || version != kVersion) return false;
+        if (!get(data, end, channelCount) || !get(data, end, rate) || !get(data, end, bucket) ||
+            !get(data, end, levelFanout) || !get(data, end, levelCount) || !get(data, end, frameCount)) {
+            return false;
+        }
+        if (channelCount < 1 || channelCount > 32 || bucket < 16 || bucket > 65536 ||
+            levelFanout < 2 || levelFanout > 256 || levelCount < 1 || levelCount > kMaxLevels ||
+            !layoutFits(bucket, levelFanout, levelCount)) {
+            return false;
+        }
+
+        channels = channelCount;
+        sampleRate = static_cast<int>(rate);
+        baseBucket = static_cast<int>(bucket);
+        fanout = levelFanout;
+        levels = levelCount;
+        clear();
+
+        // Tail buckets implied by the frame count; each stored accumulator
+        // must hold exactly the samples of its level's completed children
+        for (int level = 0; level < levels; level++) {
+            uint64_t below = level == 0 ? frameCount : frameCount / bucketFrames(level - 1);
+            pendingCount[level] = static_cast<uint32_t>(level == 0 ? below % baseBucket : below % fanout);
+        }
+        for (int level = 0; level < levels; level++) {
+            uint64_t samples = level == 0 ? pendingCount[0] : pendingCount[level] * bucketFrames(level - 1);
+            for (int c = 0; c < channels; c++) {
+                Summary& s = pending[level * channels + c];
+                if (!get(data, end, s.min) || !get(data, end, s.max) || !get(data, end, s.sumSquares) ||
+                    !get(data, end, s.count) || s.count != static_cast<double>(samples)) {
+                    clear();
+                    return false;
+                }
+            }
+        }
+        for (int level = 0; level < levels; level++) {
+            // Compare in 64 bits; size_t is 32 bits on wasm32
+            uint64_t count = frameCount / bucketFrames(level);
+            if (count > static_cast<uint64_t>(end - data) / sizeof(PeakBucket) / channels) {
+                clear();
+                return false;
+            }
+            size_t entries = static_cast<size_t>(count) * channels;
+            buckets[level].resize(entries);
+            if (entries > 0) std::memcpy(buckets[level].data(), data, entries * sizeof(PeakBucket));
+            data += entries * sizeof(PeakBucket);
+        }
+
+        frames = frameCount;
+        return true;
+    }
+
+    int getChannels() const { return channels; }
+    int getSampleRate() const { return sampleRate; }
+    int getLevels() const { return levels; }
+    uint64_t frameCount() const { return frames; }
+    uint64_t bucketFrames(int level) const {
+        uint64_t size = baseBucket;
+        for (int i = 0; i < level; i++) size *= fanout;
+        return size;
+    }
+    uint64_t bucketCount(int level) const {
+        return level >= 0 && level < levels ? buckets[level].size() / channels : 0;
+    }
+
+private:
+    // Running min/max/sum of squares over some number of samples
+    struct Summary {
+        float min = 1.0f;
+        float max = -1.0f;
+        double sumSquares = 0.0;
+        double count = 0.0;
+
+        void merge(const Summary& other) {
+            min = std::min(min, other.min);
+            max = std::max(max, other.max);
+            sumSquares += other.sumSquares;
+            count += other.count;
+        }
+    };
+
+    int channels;
+    int sampleRate;
+    int baseBucket;
+    int fanout;
+    int levels;
+    uint64_t frames = 0;
+
+    std::vector<PeakBucket> buckets[kMaxLevels]; // bucket * channels + channel
+    std::vector<Summary> pending;                // level * channels + channel
+    uint32_t pendingCount[kMaxLevels];           // samples (level 0) or child buckets
+    std::vector<float> scratch;                  // one channel's run of a bucket
+    std::vector<float> columns;
+    std::vector<uint8_t> blob;
+
+    // Whether the top-level bucket size stays within kMaxBucketFrames, so
+    // bucketFrames() never overflows
+    static bool layoutFits(uint64_t bucket, uint64_t levelFanout, int levelCount) {
+        uint64_t size = bucket;
+        for (int level = 1; level < levelCount; level++) {
+            if (size > kMaxBucketFrames / levelFanout) return false;
+            size *= levelFanout;
+        }
+        return size <= kMaxBucketFrames;
+    }
+
+    void clear() {
+        frames = 0;
+        for (int level = 0; level < kMaxLevels; level++) {
+            buckets[level].clear();
+            pendingCount[level] = 0;
+        }
+        pending.assign(static_cast<size_t>(kMaxLevels) * channels, Summary());
+        scratch.resize(baseBucket);
+    }
+
+    void append(const float* samples, size_t count, size_t channelStride, size_t frameStride) {
+        size_t done = 0;
+        while (done < count) {
+            size_t run = std::min(count - done, static_cast<size_t>(baseBucket - pendingCount[0]));
+
+            for (int c = 0; c < channels; c++) {
+                const float* src = samples + c * channelStride + done * frameStride;
+                const float* run0 = src;
+                if (frameStride != 1) {
+                    for (size_t i = 0; i < run; i++) scratch[i] = src[i * frameStride];
+                    run0 = scratch.data();
+                }
+                accumulate(run0, run, pending[c]);
+            }
+
+            done += run;
+            frames += run;
+            pendingCount[0] += static_cast<uint32_t>(run);
+            if (pendingCount[0] == static_cast<uint32_t>(baseBucket)) completeBucket(0);
+        }
+    }
+
+    // Min/max/sum of squares of a contiguous run; 32 independent lanes
+    // so the reductions vectorize without reassociating float math
+    static void accumulate(const float* __restrict src, size_t count, Summary& s) {
+        constexpr int kLanes = 32;
+        float lo[kLanes], hi[kLanes], sq[kLanes];
+        for (int j = 0; j < kLanes; j++) {
+            lo[j] = s.min;
+            hi[j] = s.max;
+            sq[j] = 0.0f;
+        }
+
+        size_t i = 0;
+        for (; i + kLanes <= count; i += kLanes) {
+            for (int j = 0; j < kLanes; j++) {
+                float v = src[i + j];
+                lo[j] = v < lo[j] ? v : lo[j];
+                hi[j] = v > hi[j] ? v : hi[j];
+                sq[j] += v * v;
+            }
+        }
+        for (; i < count; i++) {
+            float v = src[i];
+            lo[0] = v < lo[0] ? v : lo[0];
+            hi[0] = v > hi[0] ? v : hi[0];
+            sq[0] += v * v;
+        }
+
+        double sumSquares = 0.0;
+        for (int j = 0; j < kLanes; j++) {
+            s.min = std::min(s.min, lo[j]);
+            s.max = std::max(s.max, hi[j]);
+            sumSquares += sq[j];
+        }
+        s.sumSquares += sumSquares;
+        s.count += static_cast<double>(count);
+    }
+
+    // Emit the full tail bucket of a level and fold it into the level above
+    void completeBucket(int level) {
+        for (int c = 0; c < channels; c++) {
+            Summary& s = pending[level * channels + c];
+            buckets[level].push_back(quantize(s));
+            if (level + 1 < levels) pending[(level + 1) * channels + c].merge(s);
+            s = Summary();
+        }
+        pendingCount[level] = 0;
+
+        if (level + 1 < levels && ++pendingCount[level + 1] == static_cast<uint32_t>(fanout)) {
+            completeBucket(level + 1);
+        }
+    }
+
+    static PeakBucket quantize(const Summary& s) {
+        PeakBucket b;
+        b.min = static_cast<int16_t>(std::lround(std::max(-1.0f, std::min(1.0f, s.min)) * 32767.0f));
+        b.max = static_cast<int16_t>(std::lround(std::max(-1.0f, std::min(1.0f, s.max)) * 32767.0f));
+        double rms = s.count > 0 ? std::sqrt(s.sumSquares / s.count) : 0.0;
+        b.rms = static_cast<uint16_t>(std::lround(std::min(1.0, rms) * 65535.0));
+        return b;
+    }
+
+    // Merge buckets [firstBucket, lastBucket) of one level and channel;
+    // ranges past the last complete bucket fall through to finer levels
+    // and finally the level-0 tail accumulator
+    void gather(int level, uint64_t firstBucket, uint64_t lastBucket, int channel, Summary& s) const {
+        uint64_t complete = buckets[level].size() / channels;
+        uint64_t end = std::min(lastBucket, complete);
+        double size = static_cast<double>(bucketFrames(level));
+
+        for (uint64_t b = firstBucket; b < end; b++) {
+            const PeakBucket& bucket = buckets[level][b * channels + channel];
+            float rms = bucket.rms * (1.0f / 65535.0f);
+            s.min = std::min(s.min, bucket.min * (1.0f / 32767.0f));
+            s.max = std::max(s.max, bucket.max * (1.0f / 32767.0f));
+            s.sumSquares += static_cast<double>(rms) * rms * size;
+            s.count += size;
+        }
+
+        if (lastBucket <= complete) return;
+        uint64_t from = std::max(firstBucket, complete);
+        if (level > 0) {
+            gather(level - 1, from * fanout, lastBucket * fanout, channel, s);
+        } else if (from == complete && pendingCount[0] > 0) {
+            s.merge(pending[channel]);
+        }
+    }
+
+    template <typename T>
+    void put(const T& value) {
+        size_t offset = blob.size();
+        blob.resize(offset + sizeof(T));
+        std::memcpy(&blob[offset], &value, sizeof(T));
+    }
+
+    template <typename T>
+    static bool get(const uint8_t*& data, const uint8_t* end, T& value) {
+        if (static_cast<size_t>(end - data) < sizeof(T)) return false;
+        std::memcpy(&value, data, sizeof(T));
+        data += sizeof(T);
+        return true;
+    }
+};
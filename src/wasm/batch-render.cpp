@@ -0,0 +1,659 @@
+/**
+ * Batch Render - Headless native renderer for the video filter/transition kernels
+ * Runs the same code as the WASM modules (video-filters.h, video-transitions.h)
+ * over uncompressed frame streams, for offline re-renders, regression
+ * reproductions and profiling the kernels with standard tools (perf, valgrind).
+ *
+ * Input:  YUV4MPEG2 (.y4m; 4:2:0, 4:4:4 or mono) or raw RGBA, memory-mapped
+ * Output: .y4m (same header/chroma layout as the input) or raw RGBA
+ *
+ * Inputs are walked sequentially through mmap with read-ahead hints, and pages
+ * behind the read position are released, so resident memory is a fixed pool
+ * of frame buffers however long the recording is. Decoding runs on a reader
+ * thread (read-ahead) and encoding/writing on a writer thread (write-behind),
+ * connected to the filter thread by bounded queues.
+ *
+ * Usage: batch-render <descriptor>
+ *
+ * Descriptor - one directive per line, '#' starts a comment:
+ *   input session.y4m                  # or: input capture.rgba raw 1920 1080 30
+ *   output render.y4m                  # .y4m -> YUV4MPEG2, anything else -> raw RGBA
+ *   transition fade outro.y4m 120 30   # blend into a second source at frame 120 over 30 frames;
+ *                                      # a raw RGBA source needs its own suffix: ... 120 30 raw 1920 1080
+ *   sharpen 0.8                        # filters run in order on every output frame,
+ *   chromaKey 0 255 0 0.4 0.1 0.3      # arguments as in the VideoFilters API
+ *   queue 4                            # read-ahead / write-behind depth in frames
+ *   threads 4                          # threads for tile-parallel filters (temporalDenoise)
+ *
+ * Build: ./build-native.sh (Linux/macOS)
+ */
+
+#include "video-filters.h"
+#include "video-transitions.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+[[noreturn]] static void fail(const std::string& message) {
+    std::fprintf(stderr, "batch-render: %s\n", message.c_str());
+    std::exit(1);
+}
+
+static bool endsWith(const std::string& s, const std::string& suffix) {
+    return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// ─── Memory-mapped input ──────────────────────────────────────────────────────
+
+class MappedFile {
+private:
+    int fd = -1;
+    uint8_t* base = nullptr;
+    size_t length = 0;
+    size_t released = 0; // bytes below this offset have been handed back to the OS
+    size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+
+public:
+    explicit MappedFile(const std::string& path) {
+        fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) fail("cannot open " + path);
+
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size == 0) fail("cannot read " + path);
+        length = static_cast<size_t>(st.st_size);
+
+        void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) fail("cannot map " + path);
+        base = static_cast<uint8_t*>(mapped);
+        madvise(base, length, MADV_SEQUENTIAL);
+    }
+
+    ~MappedFile() {
+        if (base) munmap(base, length);
+        if (fd >= 0) close(fd);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const uint8_t* data() const { return base; }
+    size_t size() const { return length; }
+
+    // Ask the kernel to start reading [offset, offset + bytes) ahead of use
+    void prefetch(size_t offset, size_t bytes) {
+        if (offset >= length) return;
+        size_t start = offset & ~(pageSize - 1);
+        size_t end = std::min(length, offset + bytes);
+        madvise(base + start, end - start, MADV_WILLNEED);
+    }
+
+    // Drop the pages below offset; keeps RSS bounded on long inputs
+    void release(size_t offset) {
+        size_t end = offset & ~(pageSize - 1);
+        if (end <= released) return;
+        madvise(base + released, end - released, MADV_DONTNEED);
+        released = end;
+    }
+};
+
+// ─── Colour conversion (BT.601, limited range) ───────────────────────────────
+
+static inline void yuvToRgb(int y, int u, int v, uint8_t* px) {
+    int c = 298 * (y - 16) + 128;
+    int d = u - 128;
+    int e = v - 128;
+    px[0] = clampByte((c + 409 * e) >> 8);
+    px[1] = clampByte((c - 100 * d - 208 * e) >> 8);
+    px[2] = clampByte((c + 516 * d) >> 8);
+    px[3] = 255;
+}
+
+static inline uint8_t rgbToY(int r, int g, int b) { return clampByte(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16); }
+static inline uint8_t rgbToU(int r, int g, int b) { return clampByte(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128); }
+static inline uint8_t rgbToV(int r, int g, int b) { return clampByte(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128); }
+
+// ─── Stream formats ───────────────────────────────────────────────────────────
+
+enum class Chroma { RGBA, YUV420, YUV444, Mono };
+
+struct StreamFormat {
+    int width = 0;
+    int height = 0;
+    Chroma chroma = Chroma::RGBA;
+    std::string y4mHeader; // full header line (with '\n') for Y4M sources
+
+    size_t frameBytes() const {
+        size_t luma = static_cast<size_t>(width) * height;
+        size_t chromaPlane = static_cast<size_t>((width + 1) / 2) * ((height + 1) / 2);
+        switch (chroma) {
+            case Chroma::YUV420: return luma + 2 * chromaPlane;
+            case Chroma::YUV444: return luma * 3;
+            case Chroma::Mono: return luma;
+            default: return luma * 4;
+        }
+    }
+};
+
+// Sequential frame decoder over a memory-mapped Y4M or raw RGBA file
+class FrameReader {
+private:
+    MappedFile file;
+    StreamFormat format;
+    size_t position = 0;
+    size_t prefetchFrames;
+
+public:
+    FrameReader(const std::string& path, const StreamFormat* rawFormat, size_t readAhead)
+        : file(path), prefetchFrames(readAhead + 1) {
+        if (rawFormat) {
+            format = *rawFormat;
+        } else {
+            parseY4mHeader(path);
+        }
+    }
+
+    const StreamFormat& streamFormat() const { return format; }
+
+    /**
+     * Decode the next frame as RGBA
+     * @returns false at end of stream (a truncated final frame is dropped)
+     */
+    bool next(uint8_t* rgba) {
+        const uint8_t* data = file.data();
+        size_t pos = position;
+
+        if (format.chroma != Chroma::RGBA) {
+            if (pos + 5 > file.size() || std::memcmp(data + pos, "FRAME", 5) != 0) return false;
+            const void* eol = std::memchr(data + pos, '\n', file.size() - pos);
+            if (!eol) return false;
+            pos = static_cast<const uint8_t*>(eol) - data + 1;
+        }
+
+        size_t bytes = format.frameBytes();
+        if (pos + bytes > file.size()) return false;
+
+        decode(data + pos, rgba);
+        position = pos + bytes;
+
+        file.release(position);
+        file.prefetch(position, bytes * prefetchFrames);
+        return true;
+    }
+
+private:
+    void parseY4mHeader(const std::string& path) {
+        const char* data = reinterpret_cast<const char*>(file.data());
+        const void* eol = std::memchr(data, '\n', std::min<size_t>(file.size(), 1024));
+        if (!eol || file.size() < 9 || std::memcmp(data, "YUV4MPEG2", 9) != 0) {
+            fail(path + " is not a YUV4MPEG2 file (use 'raw W H' for RGBA input)");
+        }
+        size_t headerLength = static_cast<const char*>(eol) - data + 1;
+        format.y4mHeader.assign(data, headerLength);
+        format.chroma = Chroma::YUV420;
+
+        std::istringstream tokens(std::string(data + 9, headerLength - 10));
+        std::string token;
+        while (tokens >> token) {
+            switch (token[0]) {
+                case 'W': format.width = std::atoi(token.c_str() + 1); break;
+                case 'H': format.height = std::atoi(token.c_str() + 1); break;
+                case 'C':
+                    // 8-bit only; C420p10, C444p12 etc. are rejected
+                    if (token == "C420" || token == "C420jpeg" || token == "C420paldv" || token == "C420mpeg2") {
+                        format.chroma = Chroma::YUV420;
+                    }
+                    else if (token == "C444") format.chroma = Chroma::YUV444;
+                    else if (token == "Cmono") format.chroma = Chroma::Mono;
+                    else fail(path + ": unsupported Y4M colourspace " + token);
+                    break;
+                default: break;
+            }
+        }
+        if (format.width <= 0 || format.height <= 0) fail(path + ": missing Y4M dimensions");
+        position = headerLength;
+    }
+
+    void decode(const uint8_t* src, uint8_t* rgba) const {
+        const int w = format.width, h = format.height;
+        const uint8_t* yPlane = src;
+
+        switch (format.chroma) {
+            case Chroma::RGBA:
+                std::memcpy(rgba, src, format.frameBytes());
+                break;
+            case Chroma::YUV444: {
+                const uint8_t* uPlane = yPlane + static_cast<size_t>(w) * h;
+                const uint8_t* vPlane = uPlane + static_cast<size_t>(w) * h;
+                for (size_t i = 0; i < static_cast<size_t>(w) * h; i++) {
+                    yuvToRgb(yPlane[i], uPlane[i], vPlane[i], rgba + i * 4);
+                }
+                break;
+            }
+            case Chroma::YUV420: {
+                const int cw = (w + 1) / 2;
+                const uint8_t* uPlane = yPlane + static_cast<size_t>(w) * h;
+                const uint8_t* vPlane = uPlane + static_cast<size_t>(cw) * ((h + 1) / 2);
+                for (int y = 0; y < h; y++) {
+                    const uint8_t* uRow = uPlane + static_cast<size_t>(y / 2) * cw;
+                    const uint8_t* vRow = vPlane + static_cast<size_t>(y / 2) * cw;
+                    for (int x = 0; x < w; x++) {
+                        size_t i = static_cast<size_t>(y) * w + x;
+                        yuvToRgb(yPlane[i], uRow[x / 2], vRow[x / 2], rgba + i * 4);
+                    }
+                }
+                break;
+            }
+            case Chroma::Mono:
+                for (size_t i = 0; i < static_cast<size_t>(w) * h; i++) {
+                    yuvToRgb(yPlane[i], 128, 128, rgba + i * 4);
+                }
+                break;
+        }
+    }
+};
+
+// Frame encoder; Y4M output mirrors the input's header and chroma layout
+class FrameWriter {
+private:
+    int fd = -1;
+    std::string path;
+    StreamFormat format;
+    std::vector<uint8_t> encoded;
+
+public:
+    FrameWriter(const std::string& outputPath, const StreamFormat& input, int rawFps)
+        : path(outputPath), format(input) {
+        fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) fail("cannot create " + path);
+
+        if (!endsWith(path, ".y4m")) {
+            format.chroma = Chroma::RGBA;
+        } else if (format.chroma == Chroma::RGBA) {
+            // Raw RGBA source: keep full chroma resolution
+            format.chroma = Chroma::YUV444;
+            format.y4mHeader = "YUV4MPEG2 W" + std::to_string(format.width) + " H" + std::to_string(format.height)
+                             + " F" + std::to_string(rawFps) + ":1 Ip A1:1 C444\n";
+        }
+
+        if (format.chroma != Chroma::RGBA) {
+            writeAll(reinterpret_cast<const uint8_t*>(format.y4mHeader.data()), format.y4mHeader.size());
+        }
+        encoded.resize(format.frameBytes() + 6);
+    }
+
+    ~FrameWriter() {
+        if (fd >= 0) close(fd);
+    }
+
+    FrameWriter(const FrameWriter&) = delete;
+    FrameWriter& operator=(const FrameWriter&) = delete;
+
+    void write(const uint8_t* rgba) {
+        if (format.chroma == Chroma::RGBA) {
+            writeAll(rgba, format.frameBytes());
+            return;
+        }
+        std::memcpy(encoded.data(), "FRAME\n", 6);
+        encode(rgba, encoded.data() + 6);
+        writeAll(encoded.data(), encoded.size());
+    }
+
+private:
+    void writeAll(const uint8_t* data, size_t bytes) {
+        while (bytes > 0) {
+            ssize_t written = ::write(fd, data, bytes);
+            if (written <= 0) fail("write failed on " + path);
+            data += written;
+            bytes -= static_cast<size_t>(written);
+        }
+    }
+
+    void encode(const uint8_t* rgba, uint8_t* dst) const {
+        const int w = format.width, h = format.height;
+        uint8_t* yPlane = dst;
+        for (size_t i = 0; i < static_cast<size_t>(w) * h; i++) {
+            const uint8_t* px = rgba + i * 4;
+            yPlane[i] = rgbToY(px[0], px[1], px[2]);
+        }
+
+        if (format.chroma == Chroma::YUV444) {
+            uint8_t* uPlane = yPlane + static_cast<size_t>(w) * h;
+            uint8_t* vPlane = uPlane + static_cast<size_t>(w) * h;
+            for (size_t i = 0; i < static_cast<size_t>(w) * h; i++) {
+                const uint8_t* px = rgba + i * 4;
+                uPlane[i] = rgbToU(px[0], px[1], px[2]);
+                vPlane[i] = rgbToV(px[0], px[1], px[2]);
+            }
+        } else if (format.chroma == Chroma::YUV420) {
+            // Chroma from the 2x2 average (edge-clamped for odd sizes)
+            const int cw = (w + 1) / 2, ch = (h + 1) / 2;
+            uint8_t* uPlane = yPlane + static_cast<size_t>(w) * h;
+            uint8_t* vPlane = uPlane + static_cast<size_t>(cw) * ch;
+            for (int cy = 0; cy < ch; cy++) {
+                const uint8_t* row0 = rgba + static_cast<size_t>(2 * cy) * w * 4;
+                const uint8_t* row1 = rgba + static_cast<size_t>(std::min(2 * cy + 1, h - 1)) * w * 4;
+                for (int cx = 0; cx < cw; cx++) {
+                    int x0 = 2 * cx * 4, x1 = std::min(2 * cx + 1, w - 1) * 4;
+                    int r = (row0[x0] + row0[x1] + row1[x0] + row1[x1] + 2) >> 2;
+                    int g = (row0[x0 + 1] + row0[x1 + 1] + row1[x0 + 1] + row1[x1 + 1] + 2) >> 2;
+                    int b = (row0[x0 + 2] + row0[x1 + 2] + row1[x0 + 2] + row1[x1 + 2] + 2) >> 2;
+                    uPlane[static_cast<size_t>(cy) * cw + cx] = rgbToU(r, g, b);
+                    vPlane[static_cast<size_t>(cy) * cw + cx] = rgbToV(r, g, b);
+                }
+            }
+        }
+    }
+};
+
+// ─── Pipeline plumbing ────────────────────────────────────────────────────────
+
+template <typename T>
+class BoundedQueue {
+private:
+    std::deque<T> items;
+    size_t capacity;
+    std::mutex mutex;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+
+public:
+    explicit BoundedQueue(size_t maxItems) : capacity(maxItems) {}
+
+    void push(T item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [&] { return items.size() < capacity; });
+        items.push_back(std::move(item));
+        notEmpty.notify_one();
+    }
+
+    T pop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        notEmpty.wait(lock, [&] { return !items.empty(); });
+        T item = std::move(items.front());
+        items.pop_front();
+        notFull.notify_one();
+        return item;
+    }
+};
+
+struct Frame {
+    std::vector<uint8_t> primary;   // RGBA; filters render in place here
+    std::vector<uint8_t> secondary; // transition target when blending
+    bool blend = false;
+    float progress = 0.0f;
+};
+
+// ─── Descriptor ───────────────────────────────────────────────────────────────
+
+struct FilterSpec {
+    const char* name;
+    size_t argc;
+    void (*apply)(VideoFilters& filters, uintptr_t frame, const float* a);
+};
+
+static int toInt(float v) { return static_cast<int>(std::lround(v)); }
+
+static const FilterSpec kFilters[] = {
+    { "chromaKey", 6, [](VideoFilters& f, uintptr_t p, const float* a) {
+        f.chromaKey(p, toInt(a[0]), toInt(a[1]), toInt(a[2]), a[3], a[4], a[5]); } },
+    { "chromaKeyAdvanced", 9, [](VideoFilters& f, uintptr_t p, const float* a) {
+        f.chromaKeyAdvanced(p, toInt(a[0]), toInt(a[1]), toInt(a[2]), a[3], a[4], a[5],
+                            toInt(a[6]), a[7], a[8]); } },
+    { "colorGrade", 4, [](VideoFilters& f, uintptr_t p, const float* a) { f.colorGrade(p, a[0], a[1], a[2], a[3]); } },
+    { "blur", 1, [](VideoFilters& f, uintptr_t p, const float* a) { f.blur(p, toInt(a[0])); } },
+    { "sharpen", 1, [](VideoFilters& f, uintptr_t p, const float* a) { f.sharpen(p, a[0]); } },
+    { "unsharpMask", 3, [](VideoFilters& f, uintptr_t p, const float* a) { f.unsharpMask(p, toInt(a[0]), a[1], toInt(a[2])); } },
+    { "edgeDetect", 1, [](VideoFilters& f, uintptr_t p, const float* a) { f.edgeDetect(p, a[0]); } },
+    { "emboss", 1, [](VideoFilters& f, uintptr_t p, const float* a) { f.emboss(p, a[0]); } },
+    { "vignette", 2, [](VideoFilters& f, uintptr_t p, const float* a) { f.vignette(p, a[0], a[1]); } },
+    { "noiseReduction", 1, [](VideoFilters& f, uintptr_t p, const float* a) { f.noiseReduction(p, toInt(a[0])); } },
+    { "temporalDenoise", 2, [](VideoFilters& f, uintptr_t p, const float* a) { f.temporalDenoise(p, a[0], toInt(a[1])); } },
+    { "applyLUT", 5, [](VideoFilters& f, uintptr_t p, const float* a) { f.applyLUT(p, a[0], a[1], a[2], a[3], a[4]); } },
+};
+
+typedef const uint8_t* (VideoTransitions::*TransitionFn)(uintptr_t, uintptr_t, float);
+
+static const struct { const char* name; TransitionFn fn; } kTransitions[] = {
+    { "fade", &VideoTransitions::fade },
+    { "crossfade", &VideoTransitions::crossfade },
+    { "wipeLeft", &VideoTransitions::wipeLeft },
+    { "wipeRight", &VideoTransitions::wipeRight },
+    { "wipeUp", &VideoTransitions::wipeUp },
+    { "wipeDown", &VideoTransitions::wipeDown },
+    { "slideLeft", &VideoTransitions::slideLeft },
+    { "dissolve", &VideoTransitions::dissolve },
+    { "fadeToBlack", &VideoTransitions::fadeToBlack },
+};
+
+struct FilterStep {
+    const FilterSpec* spec;
+    std::vector<float> args;
+};
+
+struct RenderJob {
+    std::string inputPath;
+    std::string outputPath;
+    bool rawInput = false;
+    StreamFormat rawFormat;
+    int rawFps = 30;
+
+    TransitionFn transition = nullptr;
+    std::string transitionPath;
+    long transitionStart = 0;
+    long transitionLength = 0;
+    bool rawTransition = false;
+    StreamFormat transitionFormat;
+
+    std::vector<FilterStep> filters;
+    size_t queueDepth = 4;
+    int threads = 1;
+};
+
+// "raw W H" dimensions of a raw RGBA source
+static void parseRawDimensions(std::istringstream& words, StreamFormat& format, const std::string& where,
+                               const std::string& directive) {
+    if (!(words >> format.width >> format.height)) fail(where + directive + " raw needs W H");
+    if (format.width <= 0 || format.height <= 0) fail(where + directive + " raw dimensions must be positive");
+    format.chroma = Chroma::RGBA;
+}
+
+static RenderJob parseDescriptor(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) fail("cannot open descriptor " + path);
+
+    RenderJob job;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line)) {
+        lineNumber++;
+        line = line.substr(0, line.find('#'));
+        std::istringstream words(line);
+        std::string directive;
+        if (!(words >> directive)) continue;
+        const std::string where = path + ":" + std::to_string(lineNumber) + ": ";
+
+        if (directive == "input") {
+            std::string mode;
+            words >> job.inputPath >> mode;
+            if (mode == "raw") {
+                job.rawInput = true;
+                parseRawDimensions(words, job.rawFormat, where, directive);
+                words >> job.rawFps;
+            }
+        } else if (directive == "output") {
+            words >> job.outputPath;
+        } else if (directive == "transition") {
+            std::string name;
+            words >> name >> job.transitionPath >> job.transitionStart >> job.transitionLength;
+            for (const auto& t : kTransitions) {
+                if (name == t.name) job.transition = t.fn;
+            }
+            if (!job.transition) fail(where + "unknown transition " + name);
+            if (!words || job.transitionStart < 0 || job.transitionLength <= 0) {
+                fail(where + "usage: transition <type> <path> <startFrame> <lengthFrames> [raw W H]");
+            }
+            // The second source has its own format; raw RGBA needs its own dimensions
+            std::string mode;
+            if (words >> mode) {
+                if (mode != "raw") fail(where + "usage: transition <type> <path> <startFrame> <lengthFrames> [raw W H]");
+                job.rawTransition = true;
+                parseRawDimensions(words, job.transitionFormat, where, directive);
+            }
+        } else if (directive == "queue") {
+            words >> job.queueDepth;
+            job.queueDepth = std::max<size_t>(1, std::min<size_t>(job.queueDepth, 64));
+        } else if (directive == "threads") {
+            words >> job.threads;
+            job.threads = std::max(1, std::min(job.threads, 64));
+        } else {
+            FilterStep step{ nullptr, {} };
+            for (const auto& f : kFilters) {
+                if (directive == f.name) step.spec = &f;
+            }
+            if (!step.spec) fail(where + "unknown directive " + directive);
+            float value;
+            while (words >> value) step.args.push_back(value);
+            if (step.args.size() != step.spec->argc) {
+                fail(where + directive + " takes " + std::to_string(step.spec->argc) + " arguments");
+            }
+            job.filters.push_back(step);
+        }
+    }
+
+    if (job.inputPath.empty() || job.outputPath.empty()) fail(path + ": input and output are required");
+    return job;
+}
+
+// ─── Render ───────────────────────────────────────────────────────────────────
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        std::fprintf(stderr, "Usage: %s <descriptor>\n", argv[0]);
+        return 2;
+    }
+
+    RenderJob job = parseDescriptor(argv[1]);
+
+    FrameReader first(job.inputPath, job.rawInput ? &job.rawFormat : nullptr, job.queueDepth);
+    const StreamFormat format = first.streamFormat();
+    const size_t frameSize = static_cast<size_t>(format.width) * format.height * 4;
+
+    std::unique_ptr<FrameReader> second;
+    if (job.transition) {
+        second.reset(new FrameReader(job.transitionPath, job.rawTransition ? &job.transitionFormat : nullptr,
+                                     job.queueDepth));
+        const StreamFormat& other = second->streamFormat();
+        if (other.width != format.width || other.height != format.height) {
+            fail(job.transitionPath + " does not match the input dimensions");
+        }
+    }
+
+    FrameWriter writer(job.outputPath, format, job.rawFps);
+
+    // Fixed pool: read-ahead + write-behind + one frame in the filter stage
+    const size_t poolSize = 2 * job.queueDepth + 1;
+    std::vector<Frame> pool(poolSize);
+    BoundedQueue<Frame*> freeFrames(poolSize);
+    BoundedQueue<Frame*> toFilter(job.queueDepth + 1);
+    BoundedQueue<Frame*> toWrite(job.queueDepth + 1);
+    for (Frame& frame : pool) {
+        frame.primary.resize(frameSize);
+        if (second) frame.secondary.resize(frameSize);
+        freeFrames.push(&frame);
+    }
+
+    // Reader: the first input until the transition ends, overlapped with the
+    // second input from transitionStart onwards (a plain cut if the first
+    // input runs out early)
+    std::thread reader([&] {
+        const long start = job.transitionStart;
+        const long length = job.transitionLength;
+        bool firstDone = false, secondDone = !second;
+        for (long index = 0;;) {
+            bool wantFirst = !firstDone && (!second || index < start + length);
+            bool wantSecond = !secondDone && (index >= start || firstDone);
+            if (!wantFirst && !wantSecond) break;
+
+            Frame* frame = freeFrames.pop();
+            bool gotFirst = wantFirst && first.next(frame->primary.data());
+            if (wantFirst && !gotFirst) firstDone = true;
+            bool gotSecond = wantSecond &&
+                second->next(gotFirst ? frame->secondary.data() : frame->primary.data());
+            if (wantSecond && !gotSecond) secondDone = true;
+
+            if (!gotFirst && !gotSecond) {
+                freeFrames.push(frame);
+                continue;
+            }
+            frame->blend = gotFirst && gotSecond;
+            frame->progress = length > 1 ? static_cast<float>(index - start) / (length - 1) : 1.0f;
+            toFilter.push(frame);
+            index++;
+        }
+        toFilter.push(nullptr);
+    });
+
+    // Writer: encode and write behind the filter stage
+    std::thread writerThread([&] {
+        while (Frame* frame = toWrite.pop()) {
+            writer.write(frame->primary.data());
+            freeFrames.push(frame);
+        }
+    });
+
+    VideoFilters filters;
+    VideoTransitions transitions;
+    filters.setDimensions(format.width, format.height);
+    filters.setWorkerThreads(job.threads);
+    transitions.setDimensions(format.width, format.height);
+
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point begin = Clock::now();
+    Clock::duration kernelTime{};
+    long frames = 0;
+
+    while (Frame* frame = toFilter.pop()) {
+        Clock::time_point kernelStart = Clock::now();
+        uintptr_t ptr = reinterpret_cast<uintptr_t>(frame->primary.data());
+
+        if (frame->blend) {
+            const uint8_t* blended = (transitions.*job.transition)(
+                ptr, reinterpret_cast<uintptr_t>(frame->secondary.data()), frame->progress);
+            std::memcpy(frame->primary.data(), blended, frameSize);
+        }
+        for (const FilterStep& step : job.filters) {
+            step.spec->apply(filters, ptr, step.args.data());
+        }
+
+        kernelTime += Clock::now() - kernelStart;
+        frames++;
+        toWrite.push(frame);
+    }
+    toWrite.push(nullptr);
+
+    reader.join();
+    writerThread.join();
+
+    double wallSeconds = std::chrono::duration<double>(Clock::now() - begin).count();
+    double kernelMs = std::chrono::duration<double, std::milli>(kernelTime).count();
+    std::fprintf(stderr, "Rendered %ld frames (%dx%d) in %.2f s - kernels %.2f ms/frame\n",
+                 frames, format.width, format.height, wallSeconds, frames ? kernelMs / frames : 0.0);
+    return 0;
+}
@@ -1,421 +1,35 @@
 /**
- * Video Filters - High-Performance C++ WASM Module
- * Provides 10-20x faster image/video processing for Advanced Video Editor
- * 
- * Features:
- * - Chroma Key (Green Screen) with spill suppression
- * - Color Grading (LUT application)
- * - Brightness/Contrast/Saturation/Hue
- * - Blur/Sharpen filters
- * - Vignette effect
- * - Noise reduction
- * - Edge detection
+ * Video Filters - Embind exports for VideoFilters (video-filters.h) and
+ * VideoScopes (video-scopes.h)
  */
 
 #include <emscripten/bind.h>
-#include <vector>
-#include <cmath>
-#include <algorithm>
+#include "video-filters.h"
+#include "video-scopes.h"
 
 using namespace emscripten;
 
-class VideoFilters {
-private:
-    int width;
-    int height;
-    
-    // Helper: Clamp value to 0-255
-    inline uint8_t clamp(int value) const {
-        return static_cast<uint8_t>(std::max(0, std::min(255, value)));
-    }
-    
-    // Helper: Convert HSV to RGB
-    void hsvToRgb(float h, float s, float v, uint8_t& r, uint8_t& g, uint8_t& b) const {
-        float c = v * s;
-        float x = c * (1 - std::abs(fmod(h / 60.0f, 2.0f) - 1));
-        float m = v - c;
-        
-        float r1, g1, b1;
-        
-        if (h < 60) {
-            r1 = c; g1 = x; b1 = 0;
-        } else if (h < 120) {
-            r1 = x; g1 = c; b1 = 0;
-        } else if (h < 180) {
-            r1 = 0; g1 = c; b1 = x;
-        } else if (h < 240) {
-            r1 = 0; g1 = x; b1 = c;
-        } else if (h < 300) {
-            r1 = x; g1 = 0; b1 = c;
-        } else {
-            r1 = c; g1 = 0; b1 = x;
-        }
-        
-        r = clamp(static_cast<int>((r1 + m) * 255));
-        g = clamp(static_cast<int>((g1 + m) * 255));
-        b = clamp(static_cast<int>((b1 + m) * 255));
-    }
-    
-    // Helper: Convert RGB to HSV
-    void rgbToHsv(uint8_t r, uint8_t g, uint8_t b, float& h, float& s, float& v) const {
-        float rf = r / 255.0f;
-        float gf = g / 255.0f;
-        float bf = b / 255.0f;
-        
-        float maxVal = std::max({rf, gf, bf});
-        float minVal = std::min({rf, gf, bf});
-        float delta = maxVal - minVal;
-        
-        // Value
-        v = maxVal;
-        
-        // Saturation
-        s = (maxVal != 0) ? (delta / maxVal) : 0;
-        
-        // Hue
-        if (delta == 0) {
-            h = 0;
-        } else if (maxVal == rf) {
-            h = 60 * fmod((gf - bf) / delta, 6.0f);
-        } else if (maxVal == gf) {
-            h = 60 * ((bf - rf) / delta + 2);
-        } else {
-            h = 60 * ((rf - gf) / delta + 4);
-        }
-        
-        if (h < 0) h += 360;
-    }
+// Scope buffers are exposed as Uint32Array views into WASM memory; they are
+// valid until the next analyze() call
+static void analyzeFrame(VideoScopes& self, uintptr_t framePtr, int step) {
+    self.analyze(reinterpret_cast<const uint8_t*>(framePtr), step);
+}
+
+static void analyzeRows(VideoScopes& self, uintptr_t rowsPtr, int step) {
+    self.analyzeRows(reinterpret_cast<const uint8_t*>(rowsPtr), step);
+}
+
+static val histogramView(const VideoScopes& self, int channel) {
+    return val(typed_memory_view(VideoScopes::kLevels, self.histogram(channel)));
+}
+
+static val waveformView(const VideoScopes& self) {
+    return val(typed_memory_view(self.waveformSize(), self.waveform()));
+}
 
-public:
-    VideoFilters() : width(1920), height(1080) {}
-    
-    void setDimensions(int w, int h) {
-        width = w;
-        height = h;
-    }
-    
-    /**
-     * Chroma Key (Green Screen) with spill suppression
-     * @param framePtr - Pointer to RGBA pixel data
-     * @param keyR, keyG, keyB - Key color to remove
-     * @param tolerance - How much color variation to key (0-1)
-     * @param softness - Edge softness (0-1)
-     * @param spillSuppression - Reduce green/blue spill (0-1)
-     */
-    val chromaKey(uintptr_t framePtr, int keyR, int keyG, int keyB, 
-                  float tolerance, float softness, float spillSuppression) {
-        uint8_t* data = reinterpret_cast<uint8_t*>(framePtr);
-        int totalPixels = width * height * 4;
-        
-        float toleranceScaled = tolerance * 441.67f; // Max RGB distance
-        float softnessScaled = softness * 441.67f;
-        
-        for (int i = 0; i < totalPixels; i += 4) {
-            uint8_t r = data[i];
-            uint8_t g = data[i + 1];
-            uint8_t b = data[i + 2];
-            
-            // Calculate Euclidean distance from key color
-            float distance = std::sqrt(
-                (r - keyR) * (r - keyR) +
-                (g - keyG) * (g - keyG) +
-                (b - keyB) * (b - keyB)
-            );
-            
-            // Calculate alpha
-            float alpha = 1.0f;
-            if (distance < toleranceScaled) {
-                if (distance < (toleranceScaled - softnessScaled)) {
-                    alpha = 0.0f;
-                } else {
-                    alpha = (distance - (toleranceScaled - softnessScaled)) / softnessScaled;
-                }
-            }
-            
-            // Apply spill suppression
-            if (spillSuppression > 0 && alpha > 0.1f) {
-                float spillAmount = (1.0f - distance / 441.67f) * spillSuppression;
-                if (keyG > keyR && keyG > keyB) { // Green screen
-                    float avgRB = (r + b) / 2.0f;
-                    data[i + 1] = clamp(static_cast<int>(g * (1.0f - spillAmount) + avgRB * spillAmount));
-                } else if (keyB > keyR && keyB > keyG) { // Blue screen
-                    float avgRG = (r + g) / 2.0f;
-                    data[i + 2] = clamp(static_cast<int>(b * (1.0f - spillAmount) + avgRG * spillAmount));
-                }
-            }
-            
-            data[i + 3] = clamp(static_cast<int>(alpha * 255));
-        }
-        
-        return val::undefined();
-    }
-    
-    /**
-     * Color Grading - Apply brightness, contrast, saturation, hue adjustments
-     * @param framePtr - Pointer to RGBA pixel data
-     * @param brightness - (-100 to 100)
-     * @param contrast - (-100 to 100)
-     * @param saturation - (-100 to 100)
-     * @param hue - (-180 to 180 degrees)
-     */
-    val colorGrade(uintptr_t framePtr, float brightness, float contrast, 
-                   float saturation, float hue) {
-        uint8_t* data = reinterpret_cast<uint8_t*>(framePtr);
-        int totalPixels = width * height * 4;
-        
-        float brightnessF = brightness / 100.0f;
-        float contrastF = (contrast + 100.0f) / 100.0f;
-        float saturationF = (saturation + 100.0f) / 100.0f;
-        
-        for (int i = 0; i < totalPixels; i += 4) {
-            uint8_t r = data[i];
-            uint8_t g = data[i + 1];
-            uint8_t b = data[i + 2];
-            
-            // Apply brightness
-            float rf = r + brightnessF * 255;
-            float gf = g + brightnessF * 255;
-            float bf = b + brightnessF * 255;
-            
-            // Apply contrast
-            rf = ((rf / 255.0f - 0.5f) * contrastF + 0.5f) * 255;
-            gf = ((gf / 255.0f - 0.5f) * contrastF + 0.5f) * 255;
-            bf = ((bf / 255.0f - 0.5f) * contrastF + 0.5f) * 255;
-            
-            // Apply saturation and hue (convert to HSV)
-            if (saturation != 0 || hue != 0) {
-                float h, s, v;
-                rgbToHsv(clamp(static_cast<int>(rf)), 
-                        clamp(static_cast<int>(gf)), 
-                        clamp(static_cast<int>(bf)), h, s, v);
-                
-                // Adjust hue
-                h = fmod(h + hue + 360.0f, 360.0f);
-                
-                // Adjust saturation
-                s = std::max(0.0f, std::min(1.0f, s * saturationF));
-                
-                hsvToRgb(h, s, v, data[i], data[i + 1], data[i + 2]);
-            } else {
-                data[i] = clamp(static_cast<int>(rf));
-                data[i + 1] = clamp(static_cast<int>(gf));
-                data[i + 2] = clamp(static_cast<int>(bf));
-            }
-        }
-        
-        return val::undefined();
-    }
-    
-    /**
-     * Gaussian Blur - Fast box blur approximation
-     * @param framePtr - Pointer to RGBA pixel data
-     * @param radius - Blur radius (0-20)
-     */
-    val blur(uintptr_t framePtr, int radius) {
-        if (radius <= 0) return val::undefined();
-        
-        uint8_t* data = reinterpret_cast<uint8_t*>(framePtr);
-        std::vector<uint8_t> temp(width * height * 4);
-        
-        // Horizontal pass
-        for (int y = 0; y < height; y++) {
-            for (int x = 0; x < width; x++) {
-                int rSum = 0, gSum = 0, bSum = 0, aSum = 0;
-                int count = 0;
-                
-                for (int dx = -radius; dx <= radius; dx++) {
-                    int nx = std::max(0, std::min(width - 1, x + dx));
-                    int idx = (y * width + nx) * 4;
-                    rSum += data[idx];
-                    gSum += data[idx + 1];
-                    bSum += data[idx + 2];
-                    aSum += data[idx + 3];
-                    count++;
-                }
-                
-                int idx = (y * width + x) * 4;
-                temp[idx] = rSum / count;
-                temp[idx + 1] = gSum / count;
-                temp[idx + 2] = bSum / count;
-                temp[idx + 3] = aSum / count;
-            }
-        }
-        
-        // Vertical pass
-        for (int y = 0; y < height; y++) {
-            for (int x = 0; x < width; x++) {
-                int rSum = 0, gSum = 0, bSum = 0, aSum = 0;
-                int count = 0;
-                
-                for (int dy = -radius; dy <= radius; dy++) {
-                    int ny = std::max(0, std::min(height - 1, y + dy));
-                    int idx = (ny * width + x) * 4;
-                    rSum += temp[idx];
-                    gSum += temp[idx + 1];
-                    bSum += temp[idx + 2];
-                    aSum += temp[idx + 3];
-                    count++;
-                }
-                
-                int idx = (y * width + x) * 4;
-                data[idx] = rSum / count;
-                data[idx + 1] = gSum / count;
-                data[idx + 2] = bSum / count;
-                data[idx + 3] = aSum / count;
-            }
-        }
-        
-        return val::undefined();
-    }
-    
-    /**
-     * Sharpen filter
-     * @param framePtr - Pointer to RGBA pixel data
-     * @param amount - Sharpen strength (0-2)
-     */
-    val sharpen(uintptr_t framePtr, float amount) {
-        if (amount <= 0) return val::undefined();
-        
-        uint8_t* data = reinterpret_cast<uint8_t*>(framePtr);
-        std::vector<uint8_t> original(data, data + width * height * 4);
-        
-        // Apply sharpening kernel
-        for (int y = 1; y < height - 1; y++) {
-            for (int x = 1; x < width - 1; x++) {
-                int idx = (y * width + x) * 4;
-                
-                for (int c = 0; c < 3; c++) { // RGB only
-                    int center = original[idx + c] * 5;
-                    int neighbors = 
-                        original[((y-1) * width + x) * 4 + c] +
-                        original[((y+1) * width + x) * 4 + c] +
-                        original[(y * width + x-1) * 4 + c] +
-                        original[(y * width + x+1) * 4 + c];
-                    
-                    int sharpened = center - neighbors;
-                    int blended = original[idx + c] + static_cast<int>(sharpened * amount);
-                    data[idx + c] = clamp(blended);
-                }
-            }
-        }
-        
-        return val::undefined();
-    }
-    
-    /**
-     * Vignette effect
-     * @param framePtr - Pointer to RGBA pixel data
-     * @param intensity - Vignette strength (0-1)
-     * @param radius - Vignette radius (0-1)
-     */
-    val vignette(uintptr_t framePtr, float intensity, float radius) {
-        uint8_t* data = reinterpret_cast<uint8_t*>(framePtr);
-        
-        float centerX = width / 2.0f;
-        float centerY = height / 2.0f;
-        float maxDist = std::sqrt(centerX * centerX + centerY * centerY);
-        
-        for (int y = 0; y < height; y++) {
-            for (int x = 0; x < width; x++) {
-                float dx = x - centerX;
-                float dy = y - centerY;
-                float distance = std::sqrt(dx * dx + dy * dy);
-                
-                float vignetteFactor = 1.0f;
-                if (distance > maxDist * radius) {
-                    float ratio = (distance - maxDist * radius) / (maxDist * (1.0f - radius));
-                    vignetteFactor = 1.0f - std::min(1.0f, ratio) * intensity;
-                }
-                
-                int idx = (y * width + x) * 4;
-                data[idx] = clamp(static_cast<int>(data[idx] * vignetteFactor));
-                data[idx + 1] = clamp(static_cast<int>(data[idx + 1] * vignetteFactor));
-                data[idx + 2] = clamp(static_cast<int>(data[idx + 2] * vignetteFactor));
-            }
-        }
-        
-        return val::undefined();
-    }
-    
-    /**
-     * Noise Reduction - Simple median filter
-     * @param framePtr - Pointer to RGBA pixel data
-     * @param strength - Noise reduction strength (1-3)
-     */
-    val noiseReduction(uintptr_t framePtr, int strength) {
-        if (strength <= 0) return val::undefined();
-        
-        uint8_t* data = reinterpret_cast<uint8_t*>(framePtr);
-        std::vector<uint8_t> original(data, data + width * height * 4);
-        
-        for (int y = strength; y < height - strength; y++) {
-            for (int x = strength; x < width - strength; x++) {
-                for (int c = 0; c < 3; c++) { // RGB only
-                    std::vector<uint8_t> values;
-                    
-                    for (int dy = -strength; dy <= strength; dy++) {
-                        for (int dx = -strength; dx <= strength; dx++) {
-                            int idx = ((y + dy) * width + (x + dx)) * 4 + c;
-                            values.push_back(original[idx]);
-                        }
-                    }
-                    
-                    std::sort(values.begin(), values.end());
-                    int idx = (y * width + x) * 4 + c;
-                    data[idx] = values[values.size() / 2]; // Median
-                }
-            }
-        }
-        
-        return val::undefined();
-    }
-    
-    /**
-     * LUT (Look-Up Table) color grading
-     * @param framePtr - Pointer to RGBA pixel data
-     * @param preset - Preset name (warm, cool, vintage, cinematic, etc.)
-     * @param intensity - Effect intensity (0-1)
-     */
-    val applyLUT(uintptr_t framePtr, float temperature, float warmth, 
-                 float contrastAdj, float saturationAdj, float intensity) {
-        uint8_t* data = reinterpret_cast<uint8_t*>(framePtr);
-        int totalPixels = width * height * 4;
-        
-        for (int i = 0; i < totalPixels; i += 4) {
-            float r = data[i];
-            float g = data[i + 1];
-            float b = data[i + 2];
-            float origR = r, origG = g, origB = b;
-            
-            // Apply temperature (warm/cool)
-            r += temperature * 50;
-            b -= temperature * 50;
-            
-            // Apply warmth
-            r += warmth * 30;
-            g += warmth * 15;
-            
-            // Apply contrast
-            float contrastF = contrastAdj;
-            r = ((r / 255.0f - 0.5f) * contrastF + 0.5f) * 255;
-            g = ((g / 255.0f - 0.5f) * contrastF + 0.5f) * 255;
-            b = ((b / 255.0f - 0.5f) * contrastF + 0.5f) * 255;
-            
-            // Apply saturation
-            float gray = 0.2989f * r + 0.5870f * g + 0.1140f * b;
-            r = gray + saturationAdj * (r - gray);
-            g = gray + saturationAdj * (g - gray);
-            b = gray + saturationAdj * (b - gray);
-            
-            // Blend with original based on intensity
-            data[i] = clamp(static_cast<int>(r * intensity + origR * (1 - intensity)));
-            data[i + 1] = clamp(static_cast<int>(g * intensity + origG * (1 - intensity)));
-            data[i + 2] = clamp(static_cast<int>(b * intensity + origB * (1 - intensity)));
-        }
-        
-        return val::undefined();
-    }
-};
+static val vectorscopeView(const VideoScopes& self) {
+    return val(typed_memory_view(self.vectorscopeSize(), self.vectorscope()));
+}
 
 // Embind exports
 EMSCRIPTEN_BINDINGS(video_filters) {
@@ -423,10 +37,41 @@ EMSCRIPTEN_BINDINGS(video_filters) {
         .constructor<>()
         .function("setDimensions", &VideoFilters::setDimensions)
         .function("chromaKey", &VideoFilters::chromaKey)
+        .function("chromaKeyAdvanced", &VideoFilters::chromaKeyAdvanced)
+        .function("resetChromaKey", &VideoFilters::resetChromaKey)
         .function("colorGrade", &VideoFilters::colorGrade)
         .function("blur", &VideoFilters::blur)
         .function("sharpen", &VideoFilters::sharpen)
+        .function("unsharpMask", &VideoFilters::unsharpMask)
+        .function("edgeDetect", &VideoFilters::edgeDetect)
+        .function("emboss", &VideoFilters::emboss)
         .function("vignette", &VideoFilters::vignette)
         .function("noiseReduction", &VideoFilters::noiseReduction)
+        .function("temporalDenoise", &VideoFilters::temporalDenoise)
+        .function("resetTemporalDenoise", &VideoFilters::resetTemporalDenoise)
+        .function("setWorkerThreads", &VideoFilters::setWorkerThreads)
         .function("applyLUT", &VideoFilters::applyLUT);
+
+    value_object<LevelsSuggestion>("LevelsSuggestion")
+        .field("brightness", &LevelsSuggestion::brightness)
+        .field("contrast", &LevelsSuggestion::contrast);
+
+    value_object<WhiteBalanceSuggestion>("WhiteBalanceSuggestion")
+        .field("temperature", &WhiteBalanceSuggestion::temperature)
+        .field("warmth", &WhiteBalanceSuggestion::warmth);
+
+    class_<VideoScopes>("VideoScopes")
+        .constructor<>()
+        .function("setDimensions", &VideoScopes::setDimensions)
+        .function("setWaveformWidth", &VideoScopes::setWaveformWidth)
+        .function("getWaveformWidth", &VideoScopes::getWaveformWidth)
+        .function("analyze", &analyzeFrame)
+        .function("analyzeRows", &analyzeRows)
+        .function("sampledRows", &VideoScopes::sampledRows)
+        .function("histogram", &histogramView)
+        .function("waveform", &waveformView)
+        .function("vectorscope", &vectorscopeView)
+        .function("sampleCount", &VideoScopes::sampleCount)
+        .function("autoLevels", &VideoScopes::autoLevels)
+        .function("autoWhiteBalance", &VideoScopes::autoWhiteBalance);
 }
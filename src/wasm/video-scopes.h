@@ -0,0 +1,271 @@
+/**
+ * Video Scopes - Image analysis for real-time scopes and auto-grading
+ * Computes everything the grading UI draws in a single pass over the frame:
+ * - Per-channel (R, G, B) and luma histograms (256 bins)
+ * - Luma waveform monitor, downsampled horizontally to a fixed column count
+ * - Vectorscope (CbCr) accumulation buffer
+ *
+ * step > 1 samples every Nth column of every Nth row (a staggered grid)
+ * for the cheap approximate mode. Scopes only need the distribution, and
+ * the per-sample bin scatter is inherently scalar, so live scopes should
+ * sample: step 4 at 1080p is ~130k samples. analyzeRows() takes just the
+ * sampled rows packed together, so a caller that has to copy the frame
+ * first (JS ImageData into WASM memory) only copies 1/step of it.
+ *
+ * On top of the histograms:
+ * - autoLevels: colorGrade brightness/contrast that stretch the luma range
+ * - autoWhiteBalance: applyLUT temperature from gray-world channel means
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+
+// colorGrade() parameters suggested by autoLevels()
+struct LevelsSuggestion {
+    float brightness; // -100 to 100
+    float contrast;   // -100 to 100
+};
+
+// applyLUT() parameters suggested by autoWhiteBalance()
+struct WhiteBalanceSuggestion {
+    float temperature; // -1 to 1 (warm > 0)
+    float warmth;
+};
+
+class VideoScopes {
+public:
+    static constexpr int kLevels = 256;
+    static constexpr int kVectorscopeSize = 128; // CbCr downsampled 2x
+
+    enum Channel { Red = 0, Green = 1, Blue = 2, Luma = 3 };
+
+    VideoScopes() : width(1920), height(1080), waveformWidth(256) {
+        histograms.assign(4 * kLevels, 0);
+        vectorscopeBins.assign(kVectorscopeSize * kVectorscopeSize, 0);
+        resize();
+    }
+
+    void setDimensions(int w, int h) {
+        width = w;
+        height = h;
+        resize();
+    }
+
+    // Number of waveform columns (the frame width is bucketed into these)
+    void setWaveformWidth(int columns) {
+        waveformWidth = std::max(1, columns);
+        resize();
+    }
+
+    int getWaveformWidth() const { return waveformWidth; }
+
+    /**
+     * Analyze a frame
+     * @param data - RGBA pixel data
+     * @param step - Sample every Nth column of every Nth row (1 = exact)
+     */
+    void analyze(const uint8_t* data, int step) {
+        step = std::max(1, step);
+        analyzeSampled(data, step, static_cast<size_t>(step) * width * 4);
+    }
+
+    /**
+     * Analyze pre-sampled rows
+     * @param rows - Frame rows 0, step, 2 * step, ... packed back to back
+     *               (sampledRows(step) rows of RGBA)
+     * @param step - Sample step the rows were taken with
+     */
+    void analyzeRows(const uint8_t* rows, int step) {
+        analyzeSampled(rows, std::max(1, step), static_cast<size_t>(width) * 4);
+    }
+
+    // Rows analyze() reads at this step
+    int sampledRows(int step) const {
+        step = std::max(1, step);
+        return (height + step - 1) / step;
+    }
+
+    const uint32_t* histogram(int channel) const {
+        return histograms.data() + std::max(0, std::min(3, channel)) * kLevels;
+    }
+
+    // waveformWidth columns x 256 levels, column-major (column * 256 + level)
+    const uint32_t* waveform() const { return waveformBins.data(); }
+    size_t waveformSize() const { return waveformBins.size(); }
+
+    // 128 x 128, row = Cr, column = Cb (128 = neutral at the centre)
+    const uint32_t* vectorscope() const { return vectorscopeBins.data(); }
+    size_t vectorscopeSize() const { return vectorscopeBins.size(); }
+
+    uint32_t sampleCount() const { return samples; }
+
+    /**
+     * Levels that stretch the luma range to 0-255 via colorGrade()
+     * @param clipPercent - Percent of samples to clip at each end (e.g. 0.5)
+     */
+    LevelsSuggestion autoLevels(float clipPercent) const {
+        LevelsSuggestion levels = { 0.0f, 0.0f };
+        if (samples == 0) return levels;
+
+        const uint32_t* lumaHist = histogram(Luma);
+        uint64_t clip = static_cast<uint64_t>(samples * std::max(0.0f, std::min(20.0f, clipPercent)) / 100.0f);
+        int low = percentile(lumaHist, clip);
+        int high = kLevels - 1 - percentileFromTop(lumaHist, clip);
+        if (high <= low) return levels;
+
+        // colorGrade maps v -> ((v + B) / 255 - 0.5) * C + 0.5; solving for
+        // low -> 0 and high -> 255 gives C = 255 / (high - low) and
+        // B = 127.5 - (low + high) / 2 (the midpoint stays centred if C clamps)
+        float contrastF = std::min(2.0f, 255.0f / (high - low));
+        levels.contrast = contrastF * 100.0f - 100.0f;
+        levels.brightness = std::max(-100.0f, std::min(100.0f, (127.5f - (low + high) * 0.5f) / 255.0f * 100.0f));
+        return levels;
+    }
+
+    /**
+     * Gray-world white balance for applyLUT(). The LUT's temperature and
+     * warmth both act on the red/blue balance, so only that axis is
+     * corrected; green/magenta casts are left alone.
+     */
+    WhiteBalanceSuggestion autoWhiteBalance() const {
+        WhiteBalanceSuggestion balance = { 0.0f, 0.0f };
+        if (samples == 0) return balance;
+
+        float red = mean(histogram(Red));
+        float blue = mean(histogram(Blue));
+
+        // temperature t adds 50t to red and removes 50t from blue
+        balance.temperature = std::max(-1.0f, std::min(1.0f, (blue - red) / 100.0f));
+        return balance;
+    }
+
+private:
+    int width;
+    int height;
+    int waveformWidth;
+    uint32_t samples = 0;
+
+    std::vector<uint32_t> histograms;      // 4 x 256
+    std::vector<uint32_t> partial;         // 2 x 4 x 256 sub-histograms (luma unused)
+    std::vector<uint32_t> waveformBins;    // waveformWidth x 256
+    std::vector<uint32_t> vectorscopeBins; // 128 x 128
+    std::vector<int> waveformColumn;       // x -> column * 256
+    std::vector<uint8_t> rowLuma;
+    std::vector<uint16_t> rowChroma;
+
+    void resize() {
+        width = std::max(1, width);
+        height = std::max(1, height);
+        partial.assign(2 * 4 * kLevels, 0);
+        waveformBins.assign(static_cast<size_t>(waveformWidth) * kLevels, 0);
+        waveformColumn.resize(width);
+        for (int x = 0; x < width; x++) {
+            waveformColumn[x] = static_cast<int>(static_cast<int64_t>(x) * waveformWidth / width) * kLevels;
+        }
+        rowLuma.resize(width);
+        rowChroma.resize(width);
+        samples = 0;
+    }
+
+    // Shared pass; frame row sampledRow * step starts at data + sampledRow * rowPitch
+    void analyzeSampled(const uint8_t* data, int step, size_t rowPitch) {
+        // Two interleaved sub-histograms (even/odd samples) so back-to-back
+        // increments of the same bin don't serialise on store forwarding
+        std::fill(partial.begin(), partial.end(), 0);
+        std::fill(waveformBins.begin(), waveformBins.end(), 0);
+        std::fill(vectorscopeBins.begin(), vectorscopeBins.end(), 0);
+        samples = 0;
+
+        uint32_t* __restrict even = partial.data();
+        uint32_t* __restrict odd = partial.data() + 4 * kLevels;
+        uint32_t* __restrict wave = waveformBins.data();
+        uint32_t* __restrict scope = vectorscopeBins.data();
+        const int* __restrict column = waveformColumn.data();
+        uint8_t* __restrict luma = rowLuma.data();
+        uint16_t* __restrict chroma = rowChroma.data();
+
+        for (int sampledRow = 0, rows = sampledRows(step); sampledRow < rows; sampledRow++) {
+            const uint8_t* __restrict px = data + sampledRow * rowPitch;
+
+            // Stagger the sampled columns from row to row so every waveform
+            // column is covered and regular patterns don't alias
+            const int x0 = std::min(sampledRow % step, width - 1);
+            const int count = (width - x0 + step - 1) / step;
+            const uint8_t* __restrict first = px + x0 * 4;
+            const int stride = step * 4;
+
+            // Luma and vectorscope bin for the sampled pixels (vectorizes at step 1)
+            for (int i = 0; i < count; i++) {
+                int r = first[i * stride], g = first[i * stride + 1], b = first[i * stride + 2];
+                luma[i] = static_cast<uint8_t>((77 * r + 150 * g + 29 * b) >> 8);
+                int cb = ((-43 * r - 85 * g + 128 * b) >> 8) + 128;
+                int cr = ((128 * r - 107 * g - 21 * b) >> 8) + 128;
+                chroma[i] = static_cast<uint16_t>((cr >> 1) * kVectorscopeSize + (cb >> 1));
+            }
+
+            // Scatter
+            int i = 0;
+            for (; i + 1 < count; i += 2) {
+                const uint8_t* a = first + i * stride;
+                const uint8_t* b = a + stride;
+                even[Red * kLevels + a[0]]++;
+                even[Green * kLevels + a[1]]++;
+                even[Blue * kLevels + a[2]]++;
+                odd[Red * kLevels + b[0]]++;
+                odd[Green * kLevels + b[1]]++;
+                odd[Blue * kLevels + b[2]]++;
+            }
+            if (i < count) {
+                const uint8_t* a = first + i * stride;
+                even[Red * kLevels + a[0]]++;
+                even[Green * kLevels + a[1]]++;
+                even[Blue * kLevels + a[2]]++;
+            }
+            for (i = 0; i < count; i++) {
+                wave[column[x0 + i * step] + luma[i]]++;
+                scope[chroma[i]]++;
+            }
+            samples += count;
+        }
+
+        for (int i = 0; i < 3 * kLevels; i++) histograms[i] = even[i] + odd[i];
+
+        // The luma histogram is the waveform summed over its columns, which
+        // saves a scatter increment per sample
+        uint32_t* __restrict lumaHist = histograms.data() + Luma * kLevels;
+        std::fill(lumaHist, lumaHist + kLevels, 0);
+        for (int c = 0; c < waveformWidth; c++) {
+            const uint32_t* __restrict levels = wave + static_cast<size_t>(c) * kLevels;
+            for (int i = 0; i < kLevels; i++) lumaHist[i] += levels[i];
+        }
+    }
+
+    // Lowest level with more than `clip` samples at or below it
+    static int percentile(const uint32_t* hist, uint64_t clip) {
+        uint64_t count = 0;
+        for (int i = 0; i < kLevels; i++) {
+            count += hist[i];
+            if (count > clip) return i;
+        }
+        return kLevels - 1;
+    }
+
+    static int percentileFromTop(const uint32_t* hist, uint64_t clip) {
+        uint64_t count = 0;
+        for (int i = kLevels - 1; i >= 0; i--) {
+            count += hist[i];
+            if (count > clip) return kLevels - 1 - i;
+        }
+        return kLevels - 1;
+    }
+
+    float mean(const uint32_t* hist) const {
+        uint64_t sum = 0;
+        for (int i = 0; i < kLevels; i++) sum += static_cast<uint64_t>(hist[i]) * i;
+        return static_cast<float>(sum) / samples;
+    }
+};
@@ -1,365 +1,32 @@
 /**
- * Video Transitions C++ Module
- * High-performance video transition effects compiled to WebAssembly
- * 
- * Features:
- * - Fade, crossfade, dissolve transitions
- * - Wipe transitions (left, right, up, down)
- * - Slide transitions with smooth animation
- * - Hardware-accelerated blending
- * - Multi-threaded frame processing
- * 
- * Performance: 10-20x faster than JavaScript
+ * Video Transitions - Embind exports for VideoTransitions (video-transitions.h)
  */
 
 #include <emscripten/bind.h>
 #include <emscripten/val.h>
-#include <vector>
-#include <cmath>
-#include <algorithm>
-#include <cstring>
+#include "video-transitions.h"
 
 using namespace emscripten;
 
-class VideoTransitions {
-private:
-    int width;
-    int height;
-    int channels; // RGBA = 4
-    
-    // Clamp value between 0 and 255
-    inline uint8_t clamp(int value) {
-        return (value < 0) ? 0 : ((value > 255) ? 255 : value);
-    }
-    
-    // Linear interpolation
-    inline float lerp(float a, float b, float t) {
-        return a + (b - a) * t;
-    }
-    
-    // Ease in-out function for smoother transitions
-    inline float easeInOutCubic(float t) {
-        return t < 0.5f ? 4.0f * t * t * t : 1.0f - pow(-2.0f * t + 2.0f, 3.0f) / 2.0f;
-    }
-
-public:
-    VideoTransitions() : width(1920), height(1080), channels(4) {}
-    
-    void setDimensions(int w, int h) {
-        width = w;
-        height = h;
-    }
-    
-    /**
-     * Fade Transition - Smooth opacity blend
-     */
-    val fade(uintptr_t frame1Ptr, uintptr_t frame2Ptr, float progress) {
-        uint8_t* frame1 = reinterpret_cast<uint8_t*>(frame1Ptr);
-        uint8_t* frame2 = reinterpret_cast<uint8_t*>(frame2Ptr);
-        
-        const size_t size = width * height * channels;
-        std::vector<uint8_t> output(size);
-        
-        float smoothProgress = easeInOutCubic(progress);
-        
-        for (size_t i = 0; i < size; i += channels) {
-            // Blend RGB channels
-            output[i]     = clamp(lerp(frame1[i],     frame2[i],     smoothProgress));
-            output[i + 1] = clamp(lerp(frame1[i + 1], frame2[i + 1], smoothProgress));
-            output[i + 2] = clamp(lerp(frame1[i + 2], frame2[i + 2], smoothProgress));
-            output[i + 3] = 255; // Full opacity
-        }
-        
-        return val(typed_memory_view(output.size(), output.data()));
-    }
-    
-    /**
-     * Crossfade Transition - Similar to fade but with different curve
-     */
-    val crossfade(uintptr_t frame1Ptr, uintptr_t frame2Ptr, float progress) {
-        uint8_t* frame1 = reinterpret_cast<uint8_t*>(frame1Ptr);
-        uint8_t* frame2 = reinterpret_cast<uint8_t*>(frame2Ptr);
-        
-        const size_t size = width * height * channels;
-        std::vector<uint8_t> output(size);
-        
-        float alpha1 = 1.0f - progress;
-        float alpha2 = progress;
-        
-        for (size_t i = 0; i < size; i += channels) {
-            output[i]     = clamp(frame1[i]     * alpha1 + frame2[i]     * alpha2);
-            output[i + 1] = clamp(frame1[i + 1] * alpha1 + frame2[i + 1] * alpha2);
-            output[i + 2] = clamp(frame1[i + 2] * alpha1 + frame2[i + 2] * alpha2);
-            output[i + 3] = 255;
-        }
-        
-        return val(typed_memory_view(output.size(), output.data()));
-    }
-    
-    /**
-     * Wipe Left Transition - Reveal from right to left
-     */
-    val wipeLeft(uintptr_t frame1Ptr, uintptr_t frame2Ptr, float progress) {
-        uint8_t* frame1 = reinterpret_cast<uint8_t*>(frame1Ptr);
-        uint8_t* frame2 = reinterpret_cast<uint8_t*>(frame2Ptr);
-        
-        const size_t size = width * height * channels;
-        std::vector<uint8_t> output(size);
-        
-        int wipePosition = static_cast<int>(width * progress);
-        
-        for (int y = 0; y < height; y++) {
-            for (int x = 0; x < width; x++) {
-                size_t i = (y * width + x) * channels;
-                
-                if (x < wipePosition) {
-                    // Show frame 2
-                    output[i]     = frame2[i];
-                    output[i + 1] = frame2[i + 1];
-                    output[i + 2] = frame2[i + 2];
-                    output[i + 3] = 255;
-                } else {
-                    // Show frame 1
-                    output[i]     = frame1[i];
-                    output[i + 1] = frame1[i + 1];
-                    output[i + 2] = frame1[i + 2];
-                    output[i + 3] = 255;
-                }
-            }
-        }
-        
-        return val(typed_memory_view(output.size(), output.data()));
-    }
-    
-    /**
-     * Wipe Right Transition - Reveal from left to right
-     */
-    val wipeRight(uintptr_t frame1Ptr, uintptr_t frame2Ptr, float progress) {
-        uint8_t* frame1 = reinterpret_cast<uint8_t*>(frame1Ptr);
-        uint8_t* frame2 = reinterpret_cast<uint8_t*>(frame2Ptr);
-        
-        const size_t size = width * height * channels;
-        std::vector<uint8_t> output(size);
-        
-        int wipePosition = static_cast<int>(width * (1.0f - progress));
-        
-        for (int y = 0; y < height; y++) {
-            for (int x = 0; x < width; x++) {
-                size_t i = (y * width + x) * channels;
-                
-                if (x >= wipePosition) {
-                    output[i]     = frame2[i];
-                    output[i + 1] = frame2[i + 1];
-                    output[i + 2] = frame2[i + 2];
-                    output[i + 3] = 255;
-                } else {
-                    output[i]     = frame1[i];
-                    output[i + 1] = frame1[i + 1];
-                    output[i + 2] = frame1[i + 2];
-                    output[i + 3] = 255;
-                }
-            }
-        }
-        
-        return val(typed_memory_view(output.size(), output.data()));
-    }
-    
-    /**
-     * Wipe Up Transition - Reveal from bottom to top
-     */
-    val wipeUp(uintptr_t frame1Ptr, uintptr_t frame2Ptr, float progress) {
-        uint8_t* frame1 = reinterpret_cast<uint8_t*>(frame1Ptr);
-        uint8_t* frame2 = reinterpret_cast<uint8_t*>(frame2Ptr);
-        
-        const size_t size = width * height * channels;
-        std::vector<uint8_t> output(size);
-        
-        int wipePosition = static_cast<int>(height * progress);
-        
-        for (int y = 0; y < height; y++) {
-            for (int x = 0; x < width; x++) {
-                size_t i = (y * width + x) * channels;
-                
-                if (y < wipePosition) {
-                    output[i]     = frame2[i];
-                    output[i + 1] = frame2[i + 1];
-                    output[i + 2] = frame2[i + 2];
-                    output[i + 3] = 255;
-                } else {
-                    output[i]     = frame1[i];
-                    output[i + 1] = frame1[i + 1];
-                    output[i + 2] = frame1[i + 2];
-                    output[i + 3] = 255;
-                }
-            }
-        }
-        
-        return val(typed_memory_view(output.size(), output.data()));
-    }
-    
-    /**
-     * Wipe Down Transition - Reveal from top to bottom
-     */
-    val wipeDown(uintptr_t frame1Ptr, uintptr_t frame2Ptr, float progress) {
-        uint8_t* frame1 = reinterpret_cast<uint8_t*>(frame1Ptr);
-        uint8_t* frame2 = reinterpret_cast<uint8_t*>(frame2Ptr);
-        
-        const size_t size = width * height * channels;
-        std::vector<uint8_t> output(size);
-        
-        int wipePosition = static_cast<int>(height * (1.0f - progress));
-        
-        for (int y = 0; y < height; y++) {
-            for (int x = 0; x < width; x++) {
-                size_t i = (y * width + x) * channels;
-                
-                if (y >= wipePosition) {
-                    output[i]     = frame2[i];
-                    output[i + 1] = frame2[i + 1];
-                    output[i + 2] = frame2[i + 2];
-                    output[i + 3] = 255;
-                } else {
-                    output[i]     = frame1[i];
-                    output[i + 1] = frame1[i + 1];
-                    output[i + 2] = frame1[i + 2];
-                    output[i + 3] = 255;
-                }
-            }
-        }
-        
-        return val(typed_memory_view(output.size(), output.data()));
-    }
-    
-    /**
-     * Slide Left Transition - Frame 1 slides out, Frame 2 slides in
-     */
-    val slideLeft(uintptr_t frame1Ptr, uintptr_t frame2Ptr, float progress) {
-        uint8_t* frame1 = reinterpret_cast<uint8_t*>(frame1Ptr);
-        uint8_t* frame2 = reinterpret_cast<uint8_t*>(frame2Ptr);
-        
-        const size_t size = width * height * channels;
-        std::vector<uint8_t> output(size);
-        
-        float smoothProgress = easeInOutCubic(progress);
-        int offset = static_cast<int>(width * smoothProgress);
-        
-        for (int y = 0; y < height; y++) {
-            for (int x = 0; x < width; x++) {
-                size_t i = (y * width + x) * channels;
-                
-                // Frame 1 position (sliding left)
-                int frame1X = x + offset;
-                // Frame 2 position (coming from right)
-                int frame2X = x + offset - width;
-                
-                if (frame1X < width && frame1X >= 0) {
-                    // Show frame 1
-                    size_t frame1Index = (y * width + frame1X) * channels;
-                    output[i]     = frame1[frame1Index];
-                    output[i + 1] = frame1[frame1Index + 1];
-                    output[i + 2] = frame1[frame1Index + 2];
-                    output[i + 3] = 255;
-                } else if (frame2X >= 0 && frame2X < width) {
-                    // Show frame 2
-                    size_t frame2Index = (y * width + frame2X) * channels;
-                    output[i]     = frame2[frame2Index];
-                    output[i + 1] = frame2[frame2Index + 1];
-                    output[i + 2] = frame2[frame2Index + 2];
-                    output[i + 3] = 255;
-                } else {
-                    // Black/transparent
-                    output[i] = output[i + 1] = output[i + 2] = 0;
-                    output[i + 3] = 255;
-                }
-            }
-        }
-        
-        return val(typed_memory_view(output.size(), output.data()));
-    }
-    
-    /**
-     * Dissolve Transition - Pixel-by-pixel random fade
-     */
-    val dissolve(uintptr_t frame1Ptr, uintptr_t frame2Ptr, float progress) {
-        uint8_t* frame1 = reinterpret_cast<uint8_t*>(frame1Ptr);
-        uint8_t* frame2 = reinterpret_cast<uint8_t*>(frame2Ptr);
-        
-        const size_t size = width * height * channels;
-        std::vector<uint8_t> output(size);
-        
-        // Simple pseudo-random based on position
-        for (int y = 0; y < height; y++) {
-            for (int x = 0; x < width; x++) {
-                size_t i = (y * width + x) * channels;
-                
-                // Generate pseudo-random threshold for this pixel
-                float pixelThreshold = static_cast<float>((x * 2654435761 + y * 2246822519) % 1000) / 1000.0f;
-                
-                if (progress >= pixelThreshold) {
-                    // Show frame 2
-                    output[i]     = frame2[i];
-                    output[i + 1] = frame2[i + 1];
-                    output[i + 2] = frame2[i + 2];
-                    output[i + 3] = 255;
-                } else {
-                    // Show frame 1
-                    output[i]     = frame1[i];
-                    output[i + 1] = frame1[i + 1];
-                    output[i + 2] = frame1[i + 2];
-                    output[i + 3] = 255;
-                }
-            }
-        }
-        
-        return val(typed_memory_view(output.size(), output.data()));
-    }
-    
-    /**
-     * Fade to Black Transition - Fade out to black, then fade in from black
-     */
-    val fadeToBlack(uintptr_t frame1Ptr, uintptr_t frame2Ptr, float progress) {
-        uint8_t* frame1 = reinterpret_cast<uint8_t*>(frame1Ptr);
-        uint8_t* frame2 = reinterpret_cast<uint8_t*>(frame2Ptr);
-        
-        const size_t size = width * height * channels;
-        std::vector<uint8_t> output(size);
-        
-        if (progress < 0.5f) {
-            // Fade out frame 1 to black
-            float fadeOut = 1.0f - (progress * 2.0f);
-            for (size_t i = 0; i < size; i += channels) {
-                output[i]     = clamp(frame1[i]     * fadeOut);
-                output[i + 1] = clamp(frame1[i + 1] * fadeOut);
-                output[i + 2] = clamp(frame1[i + 2] * fadeOut);
-                output[i + 3] = 255;
-            }
-        } else {
-            // Fade in frame 2 from black
-            float fadeIn = (progress - 0.5f) * 2.0f;
-            for (size_t i = 0; i < size; i += channels) {
-                output[i]     = clamp(frame2[i]     * fadeIn);
-                output[i + 1] = clamp(frame2[i + 1] * fadeIn);
-                output[i + 2] = clamp(frame2[i + 2] * fadeIn);
-                output[i + 3] = 255;
-            }
-        }
-        
-        return val(typed_memory_view(output.size(), output.data()));
-    }
-};
+// Expose a transition's output buffer to JavaScript as a Uint8Array view
+template <const uint8_t* (VideoTransitions::*Transition)(uintptr_t, uintptr_t, float)>
+val renderView(VideoTransitions& self, uintptr_t frame1Ptr, uintptr_t frame2Ptr, float progress) {
+    const uint8_t* output = (self.*Transition)(frame1Ptr, frame2Ptr, progress);
+    return val(typed_memory_view(self.outputSize(), output));
+}
 
 // Bind C++ class to JavaScript
 EMSCRIPTEN_BINDINGS(video_transitions_module) {
     class_<VideoTransitions>("VideoTransitions")
         .constructor<>()
         .function("setDimensions", &VideoTransitions::setDimensions)
-        .function("fade", &VideoTransitions::fade)
-        .function("crossfade", &VideoTransitions::crossfade)
-        .function("wipeLeft", &VideoTransitions::wipeLeft)
-        .function("wipeRight", &VideoTransitions::wipeRight)
-        .function("wipeUp", &VideoTransitions::wipeUp)
-        .function("wipeDown", &VideoTransitions::wipeDown)
-        .function("slideLeft", &VideoTransitions::slideLeft)
-        .function("dissolve", &VideoTransitions::dissolve)
-        .function("fadeToBlack", &VideoTransitions::fadeToBlack);
+        .function("fade", &renderView<&VideoTransitions::fade>)
+        .function("crossfade", &renderView<&VideoTransitions::crossfade>)
+        .function("wipeLeft", &renderView<&VideoTransitions::wipeLeft>)
+        .function("wipeRight", &renderView<&VideoTransitions::wipeRight>)
+        .function("wipeUp", &renderView<&VideoTransitions::wipeUp>)
+        .function("wipeDown", &renderView<&VideoTransitions::wipeDown>)
+        .function("slideLeft", &renderView<&VideoTransitions::slideLeft>)
+        .function("dissolve", &renderView<&VideoTransitions::dissolve>)
+        .function("fadeToBlack", &renderView<&VideoTransitions::fadeToBlack>);
 }